@@ -47,7 +47,7 @@ int main()
 			float predictiveAccum(0.f);
 			const uint32_t predictiveIter(360);
 			for (auto i = 0; i < predictiveIter; ++i) {
-				const float result = tester.run_predictive_scheduling_test() * 1000.f;
+				const float result = tester.run_predictive_scheduling_test(&tester.m_syncQueue) * 1000.f;
 				predictiveAccum += result;
 				predictiveMin = std::min(result, predictiveMin);
 				predictiveMax = std::max(result, predictiveMax);
@@ -62,6 +62,41 @@ int main()
 		}
 
 
+		{
+			std::cout << "Comparing sync queue modes" << std::endl;
+
+			const uint32_t compareIter(100);
+			const std::size_t throughputJobs(10000);
+			float strictPredictive(0.f), relaxedPredictive(0.f);
+			float strictThroughput(0.f), relaxedThroughput(0.f);
+			for (uint32_t i = 0; i < compareIter; ++i) {
+				strictPredictive += tester.run_predictive_scheduling_test(&tester.m_syncQueue) * 1000.f;
+				relaxedPredictive += tester.run_predictive_scheduling_test(&tester.m_relaxedSyncQueue) * 1000.f;
+				strictThroughput += tester.run_queue_throughput_test(&tester.m_syncQueue, throughputJobs) * 1000.f;
+				relaxedThroughput += tester.run_queue_throughput_test(&tester.m_relaxedSyncQueue, throughputJobs) * 1000.f;
+			}
+
+			std::cout << "Predictive scheduling average. Strict: " << strictPredictive / (float)compareIter << " ms, relaxed: " << relaxedPredictive / (float)compareIter << " ms" << std::endl;
+			std::cout << "Throughput (" << throughputJobs << " jobs) average. Strict: " << strictThroughput / (float)compareIter << " ms, relaxed: " << relaxedThroughput / (float)compareIter << " ms\n" << std::endl;
+		}
+
+		const gdul::worker_park_stats parkStats(tester.m_handler.get_park_stats());
+		std::cout << "Worker parks: " << parkStats.parks << ", wakes: " << parkStats.wakes << ", timeouts: " << parkStats.timeouts << std::endl;
+
+		const gdul::job_pool_stats poolStats(tester.m_handler.get_pool_stats());
+		std::cout << "Job pool hits: " << poolStats.hits << ", misses: " << poolStats.misses << std::endl;
+
+		const gdul::job_handler_stats stats(tester.m_handler.collect_stats());
+		for (std::size_t i = 0; i < stats.queues.size(); ++i) {
+			const gdul::job_queue_stats& queue(stats.queues[i]);
+			std::cout << "Queue #" << i << " pushed: " << queue.pushed << ", popped: " << queue.popped << ", depth: " << queue.depth << std::endl;
+		}
+		for (std::size_t i = 0; i < stats.workers.size(); ++i) {
+			const gdul::worker_stats& worker(stats.workers[i]);
+			const double utilization(worker.busyTime / (stats.time > 0.0 ? stats.time : 1.0));
+			std::cout << "Worker #" << i << " jobs: " << worker.jobsExecuted << ", busy: " << worker.busyTime << " s, idle: " << worker.idleTime << " s, sleep: " << worker.sleepTime << " s, fetch: " << worker.fetchTime << " s, utilization: " << utilization * 100.0 << "%" << std::endl;
+		}
+
 #if defined (GDUL_JOB_DEBUG)
 		tester.m_handler.dump_job_graph("");
 		tester.m_handler.dump_job_time_sets("");
@@ -8,10 +8,49 @@
 #include <array>
 #include "../Common/util.h"
 #include <gdul/execution/job_handler/tracking/job_graph.h>
+#include <gdul/execution/job_handler/tracking/job_simulator.h>
 #include <gdul/execution/thread/thread.h>
 
 namespace gdul
 {
+#if defined(__cpp_impl_coroutine)
+task<int> task_child(int value)
+{
+	co_return value * 2;
+}
+task<int> task_parent(job_handler& handler, job_queue* target, std::vector<int>& collection)
+{
+	job jb(handler.make_job([]() {}, target, "task_awaited"));
+	jb.enable();
+	co_await jb;
+
+	batch_job bjb(handler.make_batch_job(collection, delegate<void(int&)>([](int& elem) { elem = 5; }), target, "task_awaited_batch"));
+	bjb.enable();
+	co_await bjb;
+
+	task<int> child(task_child(collection[0]));
+	const int first(co_await child);
+	const int second(co_await task_child(first));
+
+	co_return second;
+}
+
+// Counts destroyed coroutine frames, the parameter copy held by the frame being destroyed along with it
+struct task_frame_counter
+{
+	task_frame_counter(std::atomic<std::uint32_t>* counter) : m_counter(counter) {}
+	task_frame_counter(task_frame_counter&& other) noexcept : m_counter(std::exchange(other.m_counter, nullptr)) {}
+	~task_frame_counter() { if (m_counter) m_counter->fetch_add(1, std::memory_order_relaxed); }
+
+	std::atomic<std::uint32_t>* m_counter;
+};
+task<void> task_frame(job_handler& handler, job_queue* target, task_frame_counter)
+{
+	job jb(handler.make_job([]() {}, target, "task_frame_awaited"));
+	jb.enable();
+	co_await jb;
+}
+#endif
 
 job_handler_tester::job_handler_tester()
 	: m_info()
@@ -110,6 +149,354 @@ void job_handler_tester::basic_tests()
 
 	assert(thirdOutCollection.size() == thirdCollection.size());
 
+	std::atomic<std::uint32_t> stolenCount(0);
+	gdul::job stealRoot(m_handler.make_job([]() {}, &m_stealingQueue, "steal_root"));
+	gdul::job stealEnd(m_handler.make_job([]() {}, &m_stealingQueue, "steal_end"));
+	for (std::uint32_t i = 0; i < 64; ++i) {
+		gdul::job jb(m_handler.make_job([&stolenCount]() { stolenCount.fetch_add(1, std::memory_order_relaxed); }, &m_stealingQueue, i, "steal_intermediate"));
+		jb.depends_on(stealRoot);
+		stealEnd.depends_on(jb);
+		jb.enable();
+	}
+	stealEnd.enable();
+	stealRoot.enable();
+	stealEnd.wait_until_finished();
+
+	assert(stolenCount.load() == 64);
+
+	std::atomic<std::uint32_t> fanOutCount(0);
+	gdul::job fanOutRoot(m_handler.make_job([]() {}, &m_asyncQueue, "fan_out_root"));
+	gdul::job fanOutEnd(m_handler.make_job([]() {}, &m_asyncQueue, "fan_out_end"));
+	for (std::uint32_t i = 0; i < 200; ++i) {
+		gdul::job_queue* const target(i % 48 < 40 ? (gdul::job_queue*)&m_asyncQueue : (gdul::job_queue*)&m_syncQueue);
+		gdul::job jb(m_handler.make_job([&fanOutCount]() { fanOutCount.fetch_add(1, std::memory_order_relaxed); }, target, i, "fan_out_intermediate"));
+		jb.depends_on(fanOutRoot);
+		fanOutEnd.depends_on(jb);
+		jb.enable();
+	}
+	fanOutEnd.enable();
+	fanOutRoot.enable();
+	fanOutEnd.wait_until_finished();
+
+	assert(fanOutCount.load() == 200);
+
+	std::atomic<std::uint32_t> continuationCount(0);
+	gdul::job predecessor(m_handler.make_job([]() {}, &m_syncQueue, "then_predecessor"));
+	predecessor.enable();
+	predecessor.wait_until_finished();
+	gdul::job chain(predecessor
+		.then([&continuationCount]() { continuationCount.fetch_add(1, std::memory_order_relaxed); }, "then_first")
+		.then([&continuationCount]() { continuationCount.fetch_add(1, std::memory_order_relaxed); }, "then_second"));
+
+	std::array<gdul::job, 16> fanIn;
+	for (std::size_t i = 0; i < fanIn.size(); ++i) {
+		fanIn[i] = m_handler.make_job([&continuationCount]() { continuationCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, i, "fan_in");
+	}
+	gdul::job all(gdul::when_all(fanIn.data(), fanIn.size(), "when_all"));
+	gdul::job any(gdul::when_any({ fanIn[3], chain }, "when_any"));
+	for (gdul::job& jb : fanIn) {
+		jb.enable();
+	}
+	any.wait_until_finished();
+	all.wait_until_finished();
+	chain.wait_until_finished();
+
+	assert(continuationCount.load() == 2 + fanIn.size());
+
+	std::atomic<std::uint32_t> graphCount(0);
+	gdul::job_graph_template graph(m_handler, "tester_graph");
+	const gdul::job_graph_template::node_id graphRoot(graph.add_job([&graphCount]() { graphCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "graph_root"));
+	const gdul::job_graph_template::node_id graphEnd(graph.add_job([&graphCount]() { graphCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "graph_end"));
+	for (std::uint32_t i = 0; i < 32; ++i) {
+		const gdul::job_graph_template::node_id node(graph.add_job([&graphCount]() { graphCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "graph_intermediate"));
+		graph.add_dependency(node, graphRoot);
+		graph.add_dependency(graphEnd, node);
+	}
+	for (std::uint32_t frame = 0; frame < 8; ++frame) {
+		graph.launch().wait_until_finished();
+		graph.wait_until_finished();
+	}
+
+	assert(graphCount.load() == 8 * graph.size());
+
+	std::atomic<std::uint32_t> cancelCount(0);
+	gdul::job cancelRoot(m_handler.make_job([&cancelCount]() { cancelCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "cancel_root"));
+	gdul::job cancelSkipped(m_handler.make_job([&cancelCount]() { cancelCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "cancel_skipped"));
+	gdul::job cancelReleased(m_handler.make_job([&cancelCount]() { cancelCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "cancel_released"));
+	gdul::job cancelCascaded(m_handler.make_job([&cancelCount]() { cancelCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, "cancel_cascaded"));
+	cancelSkipped.depends_on(cancelRoot);
+	cancelReleased.depends_on(cancelSkipped);
+	cancelCascaded.depends_on(cancelReleased);
+	cancelSkipped.cancel();
+	cancelReleased.cancel(true);
+	cancelSkipped.enable();
+	cancelReleased.enable();
+	cancelCascaded.enable();
+	cancelRoot.enable();
+	cancelCascaded.wait_until_finished();
+
+	assert(cancelCount.load() == 1 && "Only the root should have run");
+	assert(cancelCascaded.is_cancelled() && "Cancellation should have cascaded");
+
+	std::vector<int> cancelCollection(1024, 1);
+	std::atomic<std::uint32_t> cancelProcessed(0);
+	gdul::batch_job cancelBatch(m_handler.make_batch_job(cancelCollection, gdul::delegate<void(int&)>([&cancelProcessed](int&) { cancelProcessed.fetch_add(1, std::memory_order_relaxed); }), &m_syncQueue, "cancel_batch"));
+	cancelBatch.cancel();
+	cancelBatch.enable();
+	cancelBatch.wait_until_finished();
+
+	assert(cancelProcessed.load() == 0 && "Cancelled batch should not process any items");
+
+	std::vector<int> guidedCollection(2048);
+	std::vector<int> guidedOutCollection;
+	for (std::size_t i = 0; i < guidedCollection.size(); ++i)
+		guidedCollection[i] = (int)i;
+
+	// Static run first, then two guided runs, the last partitioning from the item cost measured in the one before
+	for (std::uint32_t run = 0; run < 3; ++run) {
+		gdul::batch_job guided(m_handler.make_batch_job(guidedCollection, guidedOutCollection, gdul::delegate<bool(int&, int&)>([](int& in, int& out) { out = in; return in % 3 != 0; }), &m_syncQueue, "guided"));
+		guided.set_partitioning(run ? gdul::batch_partitioning_guided : gdul::batch_partitioning_static);
+		guided.enable();
+		guided.wait_until_finished();
+
+		assert(guidedOutCollection.size() == guidedCollection.size() - (guidedCollection.size() + 2) / 3);
+
+		for (std::size_t i = 1; i < guidedOutCollection.size(); ++i)
+			assert(guidedOutCollection[i - 1] < guidedOutCollection[i] && "Filtered output should preserve ordering");
+	}
+
+	// Callable processors are stored by value rather than behind a delegate
+	std::vector<int> inlineCollection(1024);
+	std::vector<int> inlineOutCollection;
+	gdul::batch_job inlineUpdate(m_handler.make_batch_job(inlineCollection, [](int& i) { i = 3; }, &m_syncQueue, "inline_update"));
+	gdul::batch_job inlineFilter(m_handler.make_batch_job(inlineCollection, inlineOutCollection, [](int& in, int& out) { out = in * 2; return true; }, &m_syncQueue, "inline_filter"));
+	inlineUpdate.enable();
+	inlineUpdate.wait_until_finished();
+	inlineFilter.enable();
+	inlineFilter.wait_until_finished();
+
+	assert(inlineOutCollection.size() == inlineCollection.size());
+	assert(std::count(inlineOutCollection.begin(), inlineOutCollection.end(), 6) == (std::ptrdiff_t)inlineOutCollection.size());
+
+	gdul::batch_job inlineReduce(m_handler.make_batch_job(inlineOutCollection, [](int& i) { return i != 6; }, &m_syncQueue, "inline_reduce"));
+	inlineReduce.enable();
+	inlineReduce.wait_until_finished();
+
+	assert(inlineOutCollection.empty());
+
+	std::vector<int> reduceCollection(1000);
+	for (std::size_t i = 0; i < reduceCollection.size(); ++i)
+		reduceCollection[i] = (int)i;
+
+	gdul::batch_job reduce(m_handler.make_reduce_job(reduceCollection, std::int64_t(0), [](int& in) { return std::int64_t(in) * 2; }, [](const std::int64_t& a, const std::int64_t& b) { return a + b; }, &m_syncQueue, "reduce"));
+	reduce.enable();
+	reduce.wait_until_finished();
+
+	assert(reduce.get_result<std::int64_t>() == 999 * 1000);
+
+	std::vector<int> sortCollection(1 << 16);
+	gdul::job sortFill(m_handler.make_job([&sortCollection]() {
+		for (std::size_t i = 0; i < sortCollection.size(); ++i)
+			sortCollection[i] = (int)((i * 7919u) % 100003u) - 50000;
+		}, &m_syncQueue, "sort_fill"));
+
+	gdul::batch_job radixSort(gdul::parallel_sort(m_handler, sortCollection, &m_syncQueue, "radix_sort"));
+	radixSort.depends_on(sortFill);
+	radixSort.enable();
+	sortFill.enable();
+	radixSort.wait_until_finished();
+
+	assert(std::is_sorted(sortCollection.begin(), sortCollection.end()) && "Radix sort output should be ordered");
+
+	std::vector<float> mergeCollection(sortCollection.size());
+	for (std::size_t i = 0; i < mergeCollection.size(); ++i)
+		mergeCollection[i] = (float)((i * 104729u) % 65521u) * 0.5f;
+
+	gdul::batch_job mergeSort(gdul::parallel_sort(m_handler, mergeCollection, std::greater<float>(), &m_syncQueue, "merge_sort"));
+	mergeSort.enable();
+	mergeSort.wait_until_finished();
+
+	assert(std::is_sorted(mergeCollection.begin(), mergeCollection.end(), std::greater<float>()) && "Merge sort output should be ordered");
+
+	// Heap owning items, long enough to not fit small string storage, so that items moved out mid merge would show
+	std::vector<std::string> stringCollection(sortCollection.size());
+	for (std::size_t i = 0; i < stringCollection.size(); ++i)
+		stringCollection[i] = "merge_sort_string_" + std::to_string((i * 104729u) % 65521u);
+
+	std::vector<std::string> stringExpected(stringCollection);
+	std::sort(stringExpected.begin(), stringExpected.end());
+
+	gdul::batch_job stringSort(gdul::parallel_sort(m_handler, stringCollection, std::less<std::string>(), &m_syncQueue, "string_sort"));
+	stringSort.enable();
+	stringSort.wait_until_finished();
+
+	assert(stringCollection == stringExpected && "String merge sort output should match std::sort");
+
+	gdul::batch_job partition(gdul::parallel_partition(m_handler, sortCollection, [](int i) { return (i & 1) == 0; }, &m_syncQueue, "partition"));
+	partition.enable();
+	partition.wait_until_finished();
+
+	const std::size_t partitionPoint(partition.get_result<std::size_t>());
+	assert(std::is_partitioned(sortCollection.begin(), sortCollection.end(), [](int i) { return (i & 1) == 0; }));
+	assert(partitionPoint == (std::size_t)std::count_if(sortCollection.begin(), sortCollection.end(), [](int i) { return (i & 1) == 0; }));
+
+	std::vector<float> rangeCollection(4096, 1.f);
+	gdul::batch_job range(m_handler.make_range_job(16, rangeCollection.size(), [&rangeCollection](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+			rangeCollection[i] *= 2.f;
+		}, &m_syncQueue, "range"));
+	range.enable();
+	range.wait_until_finished();
+
+	assert(std::count(rangeCollection.begin(), rangeCollection.end(), 2.f) == (std::ptrdiff_t)rangeCollection.size() - 16);
+
+	gdul::batch_grid grid;
+	grid.sizeX = 67;
+	grid.sizeY = 33;
+	grid.sizeZ = 3;
+	grid.tileX = 16;
+	grid.tileY = 8;
+
+	std::vector<std::uint8_t> gridCollection(grid.sizeX * grid.sizeY * grid.sizeZ, 0);
+	gdul::batch_job tiled(m_handler.make_range_job(grid, [&gridCollection, &grid](const gdul::batch_tile& tile) {
+		for (std::size_t z = tile.beginZ; z < tile.endZ; ++z)
+			for (std::size_t y = tile.beginY; y < tile.endY; ++y)
+				for (std::size_t x = tile.beginX; x < tile.endX; ++x)
+					++gridCollection[(z * grid.sizeY + y) * grid.sizeX + x];
+		}, &m_syncQueue, "tiled"));
+	tiled.enable();
+	tiled.wait_until_finished();
+
+	assert(std::count(gridCollection.begin(), gridCollection.end(), std::uint8_t(1)) == (std::ptrdiff_t)gridCollection.size() && "Each grid cell should be visited once");
+
+	std::atomic<std::uint32_t> timedCount(0);
+	const std::chrono::steady_clock::time_point timedBegin(std::chrono::steady_clock::now());
+	gdul::job timedEnd(m_handler.make_job([]() {}, &m_syncQueue, "timed_end"));
+	for (std::uint32_t i = 0; i < 16; ++i) {
+		gdul::job jb(m_handler.make_job([&timedCount]() { timedCount.fetch_add(1, std::memory_order_relaxed); }, &m_syncQueue, i, "timed"));
+		timedEnd.depends_on(jb);
+		jb.enable_after(std::chrono::microseconds(250 * i));
+	}
+	timedEnd.enable_after(std::chrono::milliseconds(5));
+	timedEnd.wait_until_finished();
+
+	assert(timedCount.load() == 16);
+	assert(!(std::chrono::steady_clock::now() - timedBegin < std::chrono::milliseconds(5)) && "Timed job should not run before its deadline");
+
+	std::atomic<std::uint32_t> relaxedCount(0);
+	gdul::job relaxedEnd(m_handler.make_job([]() {}, &m_relaxedSyncQueue, "relaxed_end"));
+	for (std::uint32_t i = 0; i < 128; ++i) {
+		gdul::job jb(m_handler.make_job([&relaxedCount]() { relaxedCount.fetch_add(1, std::memory_order_relaxed); }, &m_relaxedSyncQueue, i, "relaxed"));
+		relaxedEnd.depends_on(jb);
+		jb.enable();
+	}
+	relaxedEnd.enable();
+	relaxedEnd.wait_until_finished();
+
+	assert(relaxedCount.load() == 128);
+
+	m_handler.set_tracing_enabled(true);
+	m_handler.mark_trace_frame();
+	gdul::job tracedEnd(m_handler.make_job([]() {}, &m_asyncQueue, "traced_end"));
+	for (std::uint32_t i = 0; i < 32; ++i) {
+		gdul::job jb(m_handler.make_job([]() {}, &m_asyncQueue, i, "traced"));
+		tracedEnd.depends_on(jb);
+		jb.enable();
+	}
+	tracedEnd.enable();
+	tracedEnd.wait_until_finished();
+	m_handler.mark_trace_frame();
+	m_handler.set_tracing_enabled(false);
+
+	[[maybe_unused]] const bool recordingWritten(m_handler.dump_job_recording("job_recording.bin"));
+	assert(recordingWritten && "Failed to write job recording");
+
+	gdul::job_recording recording;
+	[[maybe_unused]] const bool recordingLoaded(recording.load("job_recording.bin"));
+	assert(recordingLoaded && "Failed to load job recording");
+	assert(recording.jobs().size() == 33 && recording.edges().size() == 32);
+
+	const gdul::job_simulator simulator(recording);
+	[[maybe_unused]] const gdul::job_simulation_result serial(simulator.run(1, gdul::job_simulation_async));
+	[[maybe_unused]] const gdul::job_simulation_result parallel(simulator.run(4, gdul::job_simulation_work_stealing));
+	assert(!(serial.makespan < parallel.makespan) && "Simulated makespan grew with more workers");
+
+	// Discards the events of the analysed frame
+	const gdul::critical_path criticalPath(m_handler.analyse_critical_path(1));
+	assert(criticalPath.frames().size() == 1);
+
+	[[maybe_unused]] const gdul::critical_path_frame& tracedFrame(criticalPath.frames().front());
+	assert(tracedFrame.m_nodes.size() == 33 && tracedFrame.m_edges.size() == 32);
+	assert(!tracedFrame.m_path.empty() && tracedFrame.m_nodes[tracedFrame.m_path.back()].m_id == tracedEnd.get_id() && "Critical path should end in traced_end");
+	assert(tracedFrame.m_nodes[tracedFrame.m_path.back()].m_critical);
+
+	[[maybe_unused]] const bool criticalPathWritten(m_handler.dump_critical_path("job_critical_path.xml", 1));
+	assert(criticalPathWritten && "Failed to write critical path report");
+
+	[[maybe_unused]] const bool traceWritten(m_handler.dump_trace("job_trace.json"));
+	assert(traceWritten && "Failed to write job trace");
+
+	const gdul::job_handler_stats stats(m_handler.collect_stats());
+	assert(stats.workers.size() == m_handler.worker_count());
+	for (const gdul::job_queue_stats& queue : stats.queues) {
+		assert(!(queue.pushed < queue.popped) && "Queue popped more jobs than were pushed");
+	}
+
+#if defined(GDUL_JOB_DEBUG)
+	// Bucket midpoints are within half a bucket of each sample: 1/16 relative above 2^TimeSetMinExponent ns, 16 ns below
+	[[maybe_unused]] const auto withinBucket([](float measured, float expected) {
+		return std::abs(measured - expected) <= std::max(expected * 0.0625f, 16e-9f);
+		});
+
+	gdul::jh_detail::time_set microseconds;
+	for (std::uint32_t i = 1; i <= 1000; ++i) {
+		microseconds.log_time((float)i * 1e-6f);
+	}
+	assert(withinBucket(microseconds.get_percentile(0.5f), 500e-6f));
+	assert(withinBucket(microseconds.get_percentile(0.99f), 990e-6f));
+
+	gdul::jh_detail::time_set nanoseconds;
+	for (std::uint32_t i = 1; i <= 25; ++i) {
+		nanoseconds.log_time((float)i * 10e-9f);
+	}
+	assert(withinBucket(nanoseconds.get_percentile(0.5f), 130e-9f) && "Linear buckets below 2^TimeSetMinExponent ns");
+
+	// Last octave starts at 2^(TimeSetMinExponent + TimeSetOctaves - 1) ns, about 34 s. Longer times saturate into its last bucket
+	gdul::jh_detail::time_set seconds;
+	seconds.log_time(1.f);
+	for (std::uint32_t i = 0; i < 198; ++i) {
+		seconds.log_time(40.f);
+	}
+	seconds.log_time(1000.f);
+	assert(withinBucket(seconds.get_percentile(0.5f), 40.f) && "Last octave");
+	assert(withinBucket(seconds.get_percentile(0.99f), 40.f) && "Last octave");
+	assert(!(seconds.get_percentile(1.f) < 64.f) && !(1000.f < seconds.get_percentile(1.f)) && "Saturated samples should land in the last bucket");
+#endif
+
+#if defined(__cpp_impl_coroutine)
+	std::vector<int> taskCollection(32);
+	task<int> parentTask(task_parent(m_handler, &m_syncQueue, taskCollection));
+	parentTask.start(m_handler, &m_syncQueue);
+	parentTask.wait_until_finished();
+
+	assert(parentTask.get_result() == 20);
+
+	// Tasks dropped while running leave their frame to be destroyed as the coroutine finishes, while tasks dropped 
+	// once finished destroy the frame themselves, possibly as the coroutine is still leaving final suspend
+	std::atomic<std::uint32_t> destroyedFrames(0);
+	for (std::uint32_t i = 0; i < 256; ++i) {
+		task<void> dropped(task_frame(m_handler, &m_asyncQueue, task_frame_counter(&destroyedFrames)));
+		dropped.start(m_handler, &m_asyncQueue);
+	}
+	for (std::uint32_t i = 0; i < 256; ++i) {
+		task<void> finished(task_frame(m_handler, &m_asyncQueue, task_frame_counter(&destroyedFrames)));
+		finished.start(m_handler, &m_asyncQueue);
+		finished.wait_until_finished();
+	}
+	while (destroyedFrames.load(std::memory_order_relaxed) != 512) {
+		std::this_thread::yield();
+	}
+#endif
 }
 void job_handler_tester::setup_workers()
 {
@@ -121,6 +508,9 @@ void job_handler_tester::setup_workers()
 		wrk.get_thread()->set_execution_priority(5);
 		//wrk.add_assignment(&m_syncQueue);
 		wrk.add_assignment(&m_syncQueue);
+		wrk.add_assignment(&m_relaxedSyncQueue);
+		wrk.add_assignment(&m_stealingQueue);
+		wrk.add_assignment(&m_asyncQueue);
 		wrk.get_thread()->set_name(std::string(std::string("DynamicWorker#") + std::to_string(i + 1)));
 		wrk.enable();
 	}
@@ -235,10 +625,10 @@ float job_handler_tester::run_consumption_strand_test(std::size_t jobs, float /*
 	return time.get();
 }
 
-float job_handler_tester::run_predictive_scheduling_test()
+float job_handler_tester::run_predictive_scheduling_test(job_queue* target)
 {
-	job root(m_handler.make_job([]() {}, &m_syncQueue, "Predictive Scheduling Root"));
-	job dependant(m_handler.make_job([]() {}, &m_syncQueue, "Predictive Scheduling End"));
+	job root(m_handler.make_job([]() {}, target, "Predictive Scheduling Root"));
+	job dependant(m_handler.make_job([]() {}, target, "Predictive Scheduling End"));
 
 	auto spinFor = [](double ms) {
 		timer<double> t;
@@ -264,7 +654,7 @@ float job_handler_tester::run_predictive_scheduling_test()
 	timer<float> time;
 
 	for (std::size_t i = 0; i < parallelSplit; ++i) {
-		job jb(m_handler.make_job(make_delegate(spinFor, serialExecutionTime), &m_syncQueue, i, "Predictive Scheduling Parallel"));
+		job jb(m_handler.make_job(make_delegate(spinFor, serialExecutionTime), target, i, "Predictive Scheduling Parallel"));
 		//jb.depends_on(root);
 		jb.enable();
 		dependant.depends_on(jb);
@@ -275,7 +665,7 @@ float job_handler_tester::run_predictive_scheduling_test()
 
 	job previous;
 	for (std::size_t i = 0; i < parallelSplit; ++i) {
-		job jb(m_handler.make_job(make_delegate(spinFor, serialExecutionTime), &m_syncQueue, i, std::string("Predictive Scheduling Serial# " + std::to_string(i)).c_str()));
+		job jb(m_handler.make_job(make_delegate(spinFor, serialExecutionTime), target, i, std::string("Predictive Scheduling Serial# " + std::to_string(i)).c_str()));
 		jb.depends_on(previous);
 		//jb.depends_on(root);
 		dependant.depends_on(jb);
@@ -300,6 +690,28 @@ float job_handler_tester::run_predictive_scheduling_test()
 
 	return result;
 }
+float job_handler_tester::run_queue_throughput_test(job_queue* target, std::size_t jobs)
+{
+	// Many tiny jobs sharing one job info. Measures raw
+	// push / fetch overhead of the target queue rather than scheduling quality
+	job root(m_handler.make_job([]() {}, target, "Queue Throughput Root"));
+	job end(m_handler.make_job([]() {}, target, "Queue Throughput End"));
+
+	timer<float> time;
+
+	for (std::size_t i = 0; i < jobs; ++i) {
+		job jb(m_handler.make_job([]() {}, target, "Queue Throughput Intermediate"));
+		jb.depends_on(root);
+		end.depends_on(jb);
+		jb.enable();
+	}
+
+	end.enable();
+	root.enable();
+	end.wait_until_finished();
+
+	return time.get();
+}
 
 void job_handler_tester::run_scatter_test_input_output(std::size_t arraySize, std::size_t stepSize, float& outBestBatchTime)
 {
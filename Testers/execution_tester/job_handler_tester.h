@@ -32,13 +32,16 @@ public:
 	float run_consumption_strand_parallel_test(std::size_t jobs, float overDuration);
 	float run_consumption_strand_test(std::size_t jobs, float overDuration);
 
-	float run_predictive_scheduling_test();
+	float run_predictive_scheduling_test(gdul::job_queue* target);
+	float run_queue_throughput_test(gdul::job_queue* target, std::size_t jobs);
 	void run_scatter_test_input_output(std::size_t arraySize, std::size_t stepSize, float& outBestBatchTime);
 
 	job_handler_tester_info m_info;
 
 	gdul::job_async_queue m_asyncQueue;
 	gdul::job_sync_queue m_syncQueue;
+	gdul::job_relaxed_sync_queue m_relaxedSyncQueue;
+	gdul::job_work_stealing_queue m_stealingQueue;
 
 	gdul::job_handler m_handler;
 
@@ -143,6 +143,11 @@ public:
 	inline void push(const T& in);
 	inline void push(T&& in);
 
+	// Pushes count items starting at first. Items are written to contiguous slots of the producer 
+	// buffer and made visible with a single store. Pass a std::move_iterator to move items in
+	template <class Iterator>
+	inline void push_bulk(Iterator first, size_type count);
+
 	bool try_pop(T& out);
 
 	// reserves a minimum capacity for the calling producer
@@ -268,6 +273,27 @@ inline void concurrent_queue<T, Allocator>::push_internal(In&& in)
 	}
 }
 template<class T, class Allocator>
+template<class Iterator>
+inline void concurrent_queue<T, Allocator>::push_bulk(Iterator first, size_type count)
+{
+	while (count) {
+		const size_type pushed(this_producer_cached()->try_push_bulk(first, count));
+
+		count -= pushed;
+
+		if (!pushed) {
+			if (this_producer_cached()->is_valid()) {
+				add_producer_buffer();
+			}
+			else {
+				init_producer(cqdetail::InitialProducerCapacity < count ? count : cqdetail::InitialProducerCapacity);
+			}
+
+			refresh_cached_producer();
+		}
+	}
+}
+template<class T, class Allocator>
 bool concurrent_queue<T, Allocator>::try_pop(T& out)
 {
 	while (!this_consumer_cached()->try_pop(out)) {
@@ -635,6 +661,10 @@ public:
 	inline bool try_push(In&& in);
 	inline bool try_pop(T& out);
 
+	// Pushes as many of count items as there are free contiguous slots for. Returns the number pushed
+	template<class Iterator>
+	inline size_type try_push_bulk(Iterator& in, size_type count);
+
 	inline size_type size() const;
 	inline size_type capacity() const noexcept;
 
@@ -936,6 +966,36 @@ inline bool producer_buffer<T, Allocator>::try_push(In&& in)
 	return true;
 }
 template<class T, class Allocator>
+template<class Iterator>
+inline typename producer_buffer<T, Allocator>::size_type producer_buffer<T, Allocator>::try_push_bulk(Iterator& in, size_type count)
+{
+	const size_type first(m_writeSlot);
+
+	size_type pushed(0);
+	for (; pushed < count; ++pushed) {
+		const size_type slot((first + pushed) & m_capacityMask);
+
+		if (m_dataBlock[slot].get_state_local() != item_state::empty) {
+			break;
+		}
+
+		++m_writeSlot;
+
+		write_in(slot, *in);
+		++in;
+
+		m_dataBlock[slot].set_state_local(item_state::valid);
+	}
+
+	if (pushed) {
+		std::atomic_thread_fence(std::memory_order_release);
+
+		m_written.store(first + pushed, std::memory_order_relaxed);
+	}
+
+	return pushed;
+}
+template<class T, class Allocator>
 inline bool producer_buffer<T, Allocator>::try_pop(T& out)
 {
 	const size_type lastWritten(m_written.load(std::memory_order_relaxed));
@@ -1078,7 +1138,7 @@ template <class T>
 class item_container
 {
 public:
-	item_container<T>(const item_container<T>&) = delete;
+	item_container(const item_container<T>&) = delete;
 	item_container<T>& operator=(const item_container&) = delete;
 
 	inline item_container();
@@ -35,9 +35,38 @@ namespace gdul
 namespace jh_detail
 {
 constexpr std::uint16_t JobPoolInitSize = 128;
-constexpr std::uint16_t MaxWorkers = 32;
 constexpr std::uint16_t BatchJobPoolInitSize = 16;
-constexpr std::uint16_t BatchJobMaxSlices = MaxWorkers * 2;
-constexpr std::uint8_t MaxWorkerTargets = 2;
+// Job and job node blocks moved per exchange between a thread and the shared pools. Threads hold up to two magazines per pool
+constexpr std::uint32_t JobBlockMagazineSize = 32;
+constexpr std::uint16_t JobReleaseBatchSize = 32;
+constexpr std::uint16_t BatchJobInlineSlices = 64;
+constexpr std::uint16_t BatchJobGuidedGrainUs = 20;
+constexpr std::uint16_t BatchJobGuidedFallbackChunks = 8;
+constexpr std::uint32_t ParallelSortMinSliceItems = 4096;
+constexpr std::uint32_t ParallelPartitionMinSliceItems = 4096;
+constexpr std::uint32_t WorkerBlockSize = 16;
+constexpr std::uint32_t WorkerTargetBlockSize = 4;
+constexpr std::uint16_t WorkStealingDequeInitSize = 64;
+constexpr std::uint16_t WorkerParkTimeoutMs = 4;
+constexpr std::uint8_t RelaxedSyncQueueBuckets = 16;
+// Lowest bucket holds jobs with less than 2^RelaxedSyncQueueMinExponent seconds remaining (about 1 us)
+constexpr std::int32_t RelaxedSyncQueueMinExponent = -20;
+constexpr std::uint16_t TimerWheelTickUs = 100;
+// Job queue push / pop counters are striped over this many cache lines, threads counting into one each
+constexpr std::uint8_t QueueCounterStripes = 8;
+// Debug time set histograms. Each octave from 2^TimeSetMinExponent ns and up is split into TimeSetSubBuckets linear 
+// buckets, keeping the relative error below 1 / TimeSetSubBuckets. Shards are keyed by worker index, workers past 
+// TimeSetShards - 1 sharing. Each shard takes about 1 KB, allocated once a worker first logs to the set
+constexpr std::uint8_t TimeSetShards = 32;
+constexpr std::uint8_t TimeSetSubBucketBits = 3;
+constexpr std::uint8_t TimeSetMinExponent = 8;
+constexpr std::uint8_t TimeSetOctaves = 28;
+// Events held per thread between trace collections. Power of two
+constexpr std::uint32_t JobTraceRingSize = 4096;
+// Slices of the parallelism profile written per frame by the critical path report
+constexpr std::uint16_t CriticalPathProfileBins = 32;
+// Jobs listed in the critical path report summary
+constexpr std::uint16_t CriticalPathReportBottlenecks = 8;
+constexpr std::uint16_t Numa_Node_Unknown = 0xffff;
 }
 }
\ No newline at end of file
@@ -31,6 +31,11 @@ void batch_job::depends_on(job & dependency)
 	if (m_impl)
 		m_impl->depends_on(dependency);
 }
+void batch_job::set_partitioning(batch_partitioning partitioning)
+{
+	if (m_impl)
+		m_impl->set_partitioning(partitioning);
+}
 bool batch_job::enable() noexcept
 {
 	return m_impl && m_impl->enable(m_impl);
@@ -71,6 +76,15 @@ void batch_job::work_until_ready(job_queue* consumeFrom)
 	if (m_impl)
 		m_impl->work_until_ready(consumeFrom);
 }
+void batch_job::cancel(bool cascade) noexcept
+{
+	if (m_impl)
+		m_impl->cancel(cascade);
+}
+bool batch_job::is_cancelled() const noexcept
+{
+	return m_impl && m_impl->is_cancelled();
+}
 batch_job::operator bool() const noexcept
 {
 	return m_impl;
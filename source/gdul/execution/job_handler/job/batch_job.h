@@ -24,6 +24,8 @@
 #include <gdul/execution/job_handler/job_handler_utility.h>
 #include <gdul/execution/job_handler/job/batch_job_impl_interface.h>
 
+#include <cassert>
+
 namespace gdul {
 class job;
 class job_queue;
@@ -34,6 +36,14 @@ struct job_info;
 
 template <class InContainer, class OutContainer, class Process>
 class batch_job_impl;
+template <class InContainer, class Result>
+class batch_reduce_job_impl;
+template <class Container, class Compare>
+class batch_sort_job_impl;
+template <class Container, class Predicate>
+class batch_partition_job_impl;
+template <class Kernel>
+class batch_range_job_impl;
 }
 
 class batch_job
@@ -43,6 +53,9 @@ public:
 
 	void depends_on(job& dependency);
 
+	// Must be set before enable. Defaults to batch_partitioning_static
+	void set_partitioning(batch_partitioning partitioning);
+
 	// this object may be discarded once enable has been invoked
 	bool enable() noexcept;
 	bool enable_locally_if_ready();
@@ -59,10 +72,20 @@ public:
 	// Consume jobs until ready. Beware of recursive calls (stack overflow, stalls etc..)
 	void work_until_ready(job_queue* consumeFrom);
 
+	// Slices that have not yet begun processing will be skipped. The output container will hold the results of 
+	// slices that completed before cancellation. If cascade is set, dependants of the batch job are cancelled
+	void cancel(bool cascade = false) noexcept;
+	bool is_cancelled() const noexcept;
+
 	operator bool() const noexcept;
 
 	// Get the number of items written to the output container
 	std::size_t get_output_size() const noexcept;
+
+	// Get the result of a reduce job, or the partition point (std::size_t) of a partition job. 
+	// T must match the result type the job was created with. Valid once finished
+	template <class T>
+	const T& get_result() const noexcept;
 private:
 	friend class job_handler;
 	friend class job;
@@ -73,7 +96,31 @@ private:
 	batch_job(shared_ptr<jh_detail::batch_job_impl<InContainer, OutContainer, Process>>&& job)
 	: m_impl(std::move(job))
 	{}
+	template <class InContainer, class Result>
+	batch_job(shared_ptr<jh_detail::batch_reduce_job_impl<InContainer, Result>>&& job)
+	: m_impl(std::move(job))
+	{}
+	template <class Container, class Compare>
+	batch_job(shared_ptr<jh_detail::batch_sort_job_impl<Container, Compare>>&& job)
+	: m_impl(std::move(job))
+	{}
+	template <class Container, class Predicate>
+	batch_job(shared_ptr<jh_detail::batch_partition_job_impl<Container, Predicate>>&& job)
+	: m_impl(std::move(job))
+	{}
+	template <class Kernel>
+	batch_job(shared_ptr<jh_detail::batch_range_job_impl<Kernel>>&& job)
+	: m_impl(std::move(job))
+	{}
 
 	shared_ptr<jh_detail::batch_job_impl_interface> m_impl;
 };
+template<class T>
+inline const T& batch_job::get_result() const noexcept
+{
+	assert(m_impl && m_impl->get_result() && "Job has no result");
+	assert(m_impl->get_result_type() == jh_detail::result_type_tag<T>() && "Result type mismatch");
+
+	return *static_cast<const T*>(m_impl->get_result());
+}
 }
@@ -0,0 +1,184 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "batch_job_graph_base.h"
+#include <gdul/execution/job_handler/job/batch_job_impl.h>
+#include <gdul/execution/job_handler/job_handler_impl.h>
+#include <gdul/execution/job_handler/job/job_impl.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace gdul {
+namespace jh_detail {
+
+batch_job_graph_base::batch_job_graph_base(job_info* info, job_handler_impl* handler, job_queue* target)
+	: m_info(info)
+	, m_handler(handler)
+	, m_target(target)
+	, m_cancelled(false)
+	, m_end(_redirect_make_job(handler, delegate<void()>(&batch_job_graph_base::finalize, this), target, info->id(), 1, "Graph Finalize"))
+	, m_enableFunc(&job::enable)
+	, m_variationCounter(2)
+	, m_selfRef()
+	, m_root(_redirect_make_job(handler, delegate<void()>(&batch_job_graph_base::initialize, this), target, info->id(), 0, "Graph Initialize"))
+{
+#if defined (GDUL_JOB_DEBUG)
+	m_info->set_job_type(job_type::job_batch);
+#endif
+}
+batch_job_graph_base::~batch_job_graph_base()
+{
+	assert(m_root.m_impl->is_enabled() && "Job destructor ran before enable was called");
+}
+void batch_job_graph_base::depends_on(job& dependency)
+{
+	m_root.depends_on(dependency);
+}
+void batch_job_graph_base::wait_until_finished() noexcept
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_end.wait_until_finished();
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+void batch_job_graph_base::wait_until_ready() noexcept
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_root.wait_until_ready();
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+void batch_job_graph_base::work_until_finished(job_queue* consumeFrom)
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_end.work_until_finished(consumeFrom);
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+void batch_job_graph_base::work_until_ready(job_queue* consumeFrom)
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_root.work_until_ready(consumeFrom);
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+void batch_job_graph_base::set_partitioning(batch_partitioning)
+{
+}
+void batch_job_graph_base::cancel(bool cascade) noexcept
+{
+	if (cascade) {
+		m_end.m_impl->cancel(job_cancel_cascade);
+	}
+
+	m_cancelled.store(true, std::memory_order_release);
+}
+bool batch_job_graph_base::is_cancelled() const noexcept
+{
+	return m_cancelled.load(std::memory_order_relaxed);
+}
+bool batch_job_graph_base::enable(const shared_ptr<batch_job_impl_interface>& selfRef) noexcept
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(m_enqueueTimer.reset())
+
+	const bool result(m_root.enable());
+	if (result) {
+		raw_ptr<batch_job_impl_interface> expected(nullptr);
+		m_selfRef.compare_exchange_strong(expected, selfRef, std::memory_order_relaxed);
+	}
+
+	return result;
+}
+bool batch_job_graph_base::enable_locally_if_ready()
+{
+	if (m_root.m_impl->enable_if_ready()) {
+
+		GDUL_JOB_DEBUG_CONDTIONAL(m_enqueueTimer.reset())
+
+		m_enableFunc = &job::enable_locally_if_ready;
+		m_root.m_impl->operator()();
+		return true;
+	}
+	return false;
+}
+bool batch_job_graph_base::is_enabled() const noexcept
+{
+	return m_root.m_impl->is_enabled();
+}
+bool batch_job_graph_base::is_finished() const noexcept
+{
+	return m_end.is_finished();
+}
+bool batch_job_graph_base::is_ready() const noexcept
+{
+	return m_root.is_ready();
+}
+job& batch_job_graph_base::get_endjob() noexcept
+{
+	return m_end;
+}
+std::size_t batch_job_graph_base::get_output_size() const noexcept
+{
+	return 0;
+}
+const void* batch_job_graph_base::get_result() const noexcept
+{
+	return nullptr;
+}
+const void* batch_job_graph_base::get_result_type() const noexcept
+{
+	return nullptr;
+}
+void batch_job_graph_base::on_finalize()
+{
+}
+std::size_t batch_job_graph_base::to_slice_count(std::size_t items, std::size_t minItems) const
+{
+	const std::size_t maxSlices(to_batch_max_slices(m_target));
+	const std::size_t slices(std::min<std::size_t>(items / minItems, maxSlices));
+
+	return slices ? slices : 1;
+}
+job batch_job_graph_base::make_graph_job(delegate<void()>&& workUnit, const std::string_view& name)
+{
+	return _redirect_make_job(m_handler, std::move(workUnit), m_target, m_info->id(), m_variationCounter++, name);
+}
+void batch_job_graph_base::enable_graph_job(job& jb)
+{
+	std::invoke(m_enableFunc, &jb);
+}
+void batch_job_graph_base::initialize()
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(m_completionTimer.reset())
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info)m_info->m_enqueueTimeSet.log_time(m_enqueueTimer.elapsed()))
+
+	m_variationCounter = 2;
+
+	build();
+
+	enable_graph_job(m_end);
+}
+void batch_job_graph_base::finalize()
+{
+	on_finalize();
+
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info)m_info->m_completionTimeSet.log_time(m_completionTimer.elapsed()))
+
+	const shared_ptr<batch_job_impl_interface> selfRef(m_selfRef.unsafe_exchange(shared_ptr<batch_job_impl_interface>(nullptr), std::memory_order_relaxed));
+}
+}
+}
@@ -0,0 +1,107 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job_handler_utility.h>
+#include <gdul/execution/job_handler/job/job.h>
+#include <gdul/execution/job_handler/job/batch_job_impl_interface.h>
+#include <gdul/execution/job_handler/tracking/timer.h>
+#include <gdul/memory/atomic_shared_ptr.h>
+
+#include <atomic>
+#include <string_view>
+
+namespace gdul {
+namespace jh_detail {
+
+class job_handler_impl;
+struct job_info;
+
+// Base for batch jobs whose job graph is built once the root job runs, such as the parallel algorithms. 
+// Derived classes build their graph in build(), attaching the jobs that must finish before the batch 
+// job has finished to m_end. m_end is enabled once build() returns
+class batch_job_graph_base : public batch_job_impl_interface
+{
+public:
+	batch_job_graph_base(job_info* info, job_handler_impl* handler, job_queue* target);
+	virtual ~batch_job_graph_base();
+
+	void depends_on(job& dependency) override final;
+
+	void wait_until_finished() noexcept override final;
+	void wait_until_ready() noexcept override final;
+	void work_until_finished(job_queue* consumeFrom) override final;
+	void work_until_ready(job_queue* consumeFrom) override final;
+
+	// Graph jobs are always partitioned statically
+	void set_partitioning(batch_partitioning partitioning) override final;
+
+	void cancel(bool cascade) noexcept override final;
+	bool is_cancelled() const noexcept override final;
+
+	bool enable(const shared_ptr<batch_job_impl_interface>& selfRef)  noexcept override final;
+	bool enable_locally_if_ready() override final;
+
+	bool is_enabled() const noexcept override final;
+	bool is_finished() const noexcept override final;
+	bool is_ready() const noexcept override final;
+
+	job& get_endjob() noexcept override final;
+
+	std::size_t get_output_size() const noexcept override;
+	const void* get_result() const noexcept override;
+	const void* get_result_type() const noexcept override;
+
+protected:
+	virtual void build() = 0;
+	virtual void on_finalize();
+
+	// Number of slices to split items into, given that no slice should hold less than minItems
+	std::size_t to_slice_count(std::size_t items, std::size_t minItems) const;
+
+	job make_graph_job(delegate<void()>&& workUnit, const std::string_view& name);
+	void enable_graph_job(job& jb);
+
+	job_info* const m_info;
+	job_handler_impl* const m_handler;
+	job_queue* const m_target;
+
+	std::atomic_bool m_cancelled;
+
+	job m_end;
+
+private:
+	void initialize();
+	void finalize();
+
+	GDUL_JOB_DEBUG_CONDTIONAL(timer m_completionTimer)
+	GDUL_JOB_DEBUG_CONDTIONAL(timer m_enqueueTimer)
+
+	bool (job::* m_enableFunc)(void);
+
+	std::size_t m_variationCounter;
+
+	atomic_shared_ptr<batch_job_impl_interface> m_selfRef;
+
+	job m_root;
+};
+}
+}
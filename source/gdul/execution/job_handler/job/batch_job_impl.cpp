@@ -37,20 +37,24 @@ gdul::job _redirect_make_job(job_handler_impl* handler, gdul::delegate<void()>&&
 	return handler->make_sub_job_internal(std::move(workUnit), target, batchId, variationId);
 #endif
 }
-bool _redirect_enable_if_ready(gdul::shared_ptr<job_impl>& jb)
+bool _redirect_enable_if_ready(job_impl_ptr& jb)
 {
 	return jb->enable_if_ready();
 }
-void _redirect_invoke_job(gdul::shared_ptr<job_impl>& jb)
+void _redirect_invoke_job(job_impl_ptr& jb)
 {
 	GDUL_JOB_DEBUG_CONDTIONAL(jb->on_enqueue())
 	jb->operator()();
 }
-bool _redirect_is_enabled(const gdul::shared_ptr<job_impl>& jb)
+bool _redirect_is_enabled(const job_impl_ptr& jb)
 {
 	return jb->is_enabled();
 }
-void _redirect_set_info(shared_ptr<job_handler_impl>& handler, gdul::shared_ptr<job_impl>& jb, std::size_t physicalId, std::size_t variationId, [[maybe_unused]] const std::string_view& name)
+void _redirect_cancel_dependants(job_impl_ptr& jb)
+{
+	jb->cancel(job_cancel_cascade);
+}
+void _redirect_set_info(shared_ptr<job_handler_impl>& handler, job_impl_ptr& jb, std::size_t physicalId, std::size_t variationId, [[maybe_unused]] const std::string_view& name)
 {
 #if defined (GDUL_JOB_DEBUG)
 	jb->set_info(handler->get_job_graph().get_sub_job_info(physicalId, variationId, name));
@@ -23,14 +23,18 @@
 #include <gdul/execution/job_handler/job_handler_utility.h>
 #include <gdul/execution/job_handler/job/job.h>
 #include <gdul/execution/job_handler/tracking/job_graph.h>
+#include <gdul/execution/job_handler/tracking/timer.h>
 #include <gdul/execution/job_handler/job/batch_job_impl_interface.h>
 
 #include <gdul/utility/delegate.h>
 
 #include <array>
+#include <vector>
 #include <cassert>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <type_traits>
 
 namespace gdul {
 
@@ -44,10 +48,26 @@ using dummy_batch_type = batch_job_impl<dummy_batch_container, dummy_batch_conta
 // Gets rid of circular dependency job_handler->batch_job_impl & batch_job_impl->job_handler
 gdul::job _redirect_make_job(job_handler_impl* handler, gdul::delegate<void()>&& workUnit, job_queue* target, std::size_t batchId, std::size_t variationId, const std::string_view& name);
 
-bool _redirect_enable_if_ready(gdul::shared_ptr<job_impl>& jb);
-void _redirect_invoke_job(gdul::shared_ptr<job_impl>& jb);
-bool _redirect_is_enabled(const gdul::shared_ptr<job_impl>& jb);
-void _redirect_set_info(shared_ptr<job_handler_impl>& handler, gdul::shared_ptr<job_impl>& jb, std::size_t physicalId, std::size_t variationId, const std::string_view& name);
+bool _redirect_enable_if_ready(job_impl_ptr& jb);
+void _redirect_invoke_job(job_impl_ptr& jb);
+bool _redirect_is_enabled(const job_impl_ptr& jb);
+void _redirect_cancel_dependants(job_impl_ptr& jb);
+void _redirect_set_info(shared_ptr<job_handler_impl>& handler, job_impl_ptr& jb, std::size_t physicalId, std::size_t variationId, const std::string_view& name);
+
+// Argument count and return type of a batch processor, be it a delegate or any other callable. Processors 
+// invocable with both an input and output reference are taken to be input / output processors
+template <class Process, class InputRef, class OutputRef, class = void>
+struct batch_process_traits
+{
+	static constexpr std::size_t NumArgs = 1;
+	using return_type = std::invoke_result_t<Process&, InputRef>;
+};
+template <class Process, class InputRef, class OutputRef>
+struct batch_process_traits<Process, InputRef, OutputRef, std::enable_if_t<std::is_invocable_v<Process&, InputRef, OutputRef>>>
+{
+	static constexpr std::size_t NumArgs = 2;
+	using return_type = std::invoke_result_t<Process&, InputRef, OutputRef>;
+};
 
 template <class InContainer, class OutContainer, class Process>
 class batch_job_impl : public batch_job_impl_interface
@@ -71,6 +91,11 @@ public:
 	void work_until_finished(job_queue* consumeFrom) override final;
 	void work_until_ready(job_queue* consumeFrom) override final;
 
+	void set_partitioning(batch_partitioning partitioning) override final;
+
+	void cancel(bool cascade) noexcept override final;
+	bool is_cancelled() const noexcept override final;
+
 	bool enable(const shared_ptr<batch_job_impl_interface>& selfRef)  noexcept override final;
 	bool enable_locally_if_ready() override final;
 
@@ -82,16 +107,27 @@ public:
 
 	std::size_t get_output_size() const noexcept override final;
 
+	const void* get_result() const noexcept override final;
+	const void* get_result_type() const noexcept override final;
+
 private:
-	static constexpr bool SpecializeInputOutput = std::is_same_v<bool, typename process_type::return_type> && process_type::NumArgs == 2;
-	static constexpr bool SpecializeInput = std::is_same_v<bool, typename process_type::return_type> && process_type::NumArgs == 1;
-	static constexpr bool SpecializeUpdate = (!std::is_same_v<bool, typename process_type::return_type>) && process_type::NumArgs == 1;
+	using process_traits = batch_process_traits<process_type, ref_input_type, ref_output_type>;
+
+	static constexpr bool SpecializeInputOutput = std::is_same_v<bool, typename process_traits::return_type> && process_traits::NumArgs == 2;
+	static constexpr bool SpecializeInput = std::is_same_v<bool, typename process_traits::return_type> && process_traits::NumArgs == 1;
+	static constexpr bool SpecializeUpdate = (!std::is_same_v<bool, typename process_traits::return_type>) && process_traits::NumArgs == 1;
+
+	using tracker_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::uint32_t>;
+	using chunk_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>;
+	using job_vector_type = std::vector<job, typename std::allocator_traits<allocator_type>::template rebind_alloc<job>>;
 
 	std::size_t to_batch_begin(std::size_t batchIndex) const;
 	std::size_t to_batch_end(std::size_t batchIndex) const;
 
 	std::uint32_t clamp_batch_size(std::size_t desired) const;
 
+	std::size_t to_guided_grain(std::size_t slices) const;
+
 	template <class Fun>
 	job make_work_slice(Fun fun, std::size_t batchIndex, std::size_t variationId, const std::string_view& name);
 
@@ -102,10 +138,19 @@ private:
 	template <class U = batch_job_impl, std::enable_if_t<U::SpecializeUpdate>* = nullptr>
 	void work_process(std::size_t batchIndex);
 
+	// Job to be run once all items have been processed
 	template <class U = batch_job_impl, std::enable_if_t<!U::SpecializeUpdate>* = nullptr>
-	void make_jobs();
+	job make_process_sink();
 	template <class U = batch_job_impl, std::enable_if_t<U::SpecializeUpdate>* = nullptr>
+	job make_process_sink();
+
 	void make_jobs();
+	void make_guided_jobs();
+
+	// Claims chunks from m_chunkCursor until none remain
+	void work_guided(std::size_t runnerIndex);
+
+	void store_element_cost();
 
 	void initialize();
 
@@ -114,14 +159,19 @@ private:
 	template <class U = batch_job_impl, std::enable_if_t<U::SpecializeUpdate>* = nullptr>
 	void finalize();
 
-	void work_pack(std::size_t batchIndex);
+	// Turns slice output counts into output end offsets and schedules the scatter jobs
+	void work_scan(std::size_t);
+	// Moves the output of a slice to its final offset
+	void work_scatter(std::size_t batchIndex);
 
 	job_info* m_info;
 
 	GDUL_JOB_DEBUG_CONDTIONAL(timer m_completionTimer)
 	GDUL_JOB_DEBUG_CONDTIONAL(timer m_enqueueTimer)
 
-	std::array<std::uint32_t, BatchJobMaxSlices> m_batchTracker;
+	// Points to m_inlineTracker unless there are more slices than fit within it
+	std::uint32_t* m_batchTracker;
+	std::array<std::uint32_t, BatchJobInlineSlices> m_inlineTracker;
 
 	process_type m_process;
 
@@ -133,8 +183,15 @@ private:
 	intput_container_type& m_input;
 	output_container_type& m_output;
 
-	const std::uint32_t m_batchSize;
-	const std::uint16_t m_batchCount;
+	std::uint32_t m_batchSize;
+	std::uint32_t m_batchCount;
+
+	// Chunk end indices, used in place of m_batchSize when partitioning is guided
+	std::size_t* m_chunkEnds;
+	std::atomic<std::uint32_t> m_chunkCursor;
+	std::atomic<float> m_processTime;
+
+	std::atomic_bool m_cancelled;
 
 	atomic_shared_ptr<batch_job_impl_interface> m_selfRef;
 
@@ -144,7 +201,8 @@ private:
 template<class InContainer, class OutContainer, class Process>
 inline batch_job_impl<InContainer, OutContainer, Process>::batch_job_impl(InContainer& input, OutContainer& output, Process&& process, job_info* info, job_handler_impl* handler, job_queue* target)
 	: m_info(info)
-	, m_batchTracker{}
+	, m_batchTracker(nullptr)
+	, m_inlineTracker{}
 	, m_process(std::move(process))
 	, m_handler(handler)
 	, m_target(target)
@@ -152,11 +210,24 @@ inline batch_job_impl<InContainer, OutContainer, Process>::batch_job_impl(InCont
 	, m_input(input)
 	, m_output(output)
 	, m_batchSize(clamp_batch_size(to_batch_size(input.size(), target)))
-	, m_batchCount((std::uint16_t)(m_input.size() / m_batchSize + ((bool)(m_input.size() % m_batchSize))))
+	, m_batchCount((std::uint32_t)(m_input.size() / m_batchSize + ((bool)(m_input.size() % m_batchSize))))
+	, m_chunkEnds(nullptr)
+	, m_chunkCursor(0)
+	, m_processTime(0.f)
+	, m_cancelled(false)
 	, m_selfRef()
 	, m_root(m_batchCount ? _redirect_make_job(handler, delegate<void()>(&batch_job_impl::initialize, this), target, m_info->id(), 0, "Batch Initialize") : _redirect_make_job(handler, delegate<void()>([]() {}), target, m_info->id(), 0, "Batch Initialize"))
 	, m_end(m_batchCount ? _redirect_make_job(handler, delegate<void()>(&batch_job_impl::finalize<>, this), target, m_info->id(), 1, "Batch Finalize") : m_root)
 {
+	if (BatchJobInlineSlices < m_batchCount) {
+		tracker_allocator_type alloc;
+		m_batchTracker = alloc.allocate(m_batchCount);
+		std::fill(m_batchTracker, m_batchTracker + m_batchCount, 0);
+	}
+	else {
+		m_batchTracker = m_inlineTracker.data();
+	}
+
 #if defined (GDUL_JOB_DEBUG)
 	m_info->set_job_type(job_type::job_batch);
 #endif
@@ -165,15 +236,32 @@ template<class InContainer, class OutContainer, class Process>
 inline batch_job_impl<InContainer, OutContainer, Process>::~batch_job_impl()
 {
 	assert(_redirect_is_enabled(m_root.m_impl) && "Job destructor ran before enable was called");
+
+	tracker_allocator_type alloc;
+
+	if (m_batchTracker != m_inlineTracker.data()) {
+		alloc.deallocate(m_batchTracker, m_batchCount);
+	}
+	if (m_chunkEnds) {
+		chunk_allocator_type chunkAlloc;
+		chunkAlloc.deallocate(m_chunkEnds, m_batchCount);
+	}
 }
 template<class InContainer, class OutContainer, class Process>
 inline std::size_t batch_job_impl<InContainer, OutContainer, Process>::to_batch_begin(std::size_t batchIndex) const
 {
+	if (m_chunkEnds) {
+		return batchIndex ? m_chunkEnds[batchIndex - 1] : 0;
+	}
 	return batchIndex * m_batchSize;
 }
 template<class InContainer, class OutContainer, class Process>
 inline std::size_t batch_job_impl<InContainer, OutContainer, Process>::to_batch_end(std::size_t batchIndex) const
 {
+	if (m_chunkEnds) {
+		return m_chunkEnds[batchIndex];
+	}
+
 	const std::size_t desiredEnd(batchIndex * m_batchSize + m_batchSize);
 	if (!(m_input.size() < desiredEnd)) {
 		return desiredEnd;
@@ -185,7 +273,7 @@ inline std::uint32_t batch_job_impl<InContainer, OutContainer, Process>::clamp_b
 {
 	const std::size_t resultantBatchCount(m_input.size() / desired + ((bool)(m_input.size() % desired)));
 	const float resultF((float)resultantBatchCount);
-	const float maxBatchCount((float)BatchJobMaxSlices);
+	const float maxBatchCount((float)to_batch_max_slices(m_target));
 
 	const float div(resultF / maxBatchCount);
 
@@ -200,6 +288,67 @@ inline std::uint32_t batch_job_impl<InContainer, OutContainer, Process>::clamp_b
 	return returnValue;
 }
 template<class InContainer, class OutContainer, class Process>
+inline std::size_t batch_job_impl<InContainer, OutContainer, Process>::to_guided_grain(std::size_t slices) const
+{
+	const float elementCost(m_info->get_element_cost());
+
+	std::size_t grain(0);
+
+	if (elementCost != 0.f) {
+		const float grainTime((float)BatchJobGuidedGrainUs * 0.000001f);
+		grain = (std::size_t)std::ceil(grainTime / elementCost);
+	}
+	else {
+		// No measurements yet
+		grain = m_input.size() / (slices * BatchJobGuidedFallbackChunks);
+	}
+
+	return grain ? grain : 1;
+}
+template<class InContainer, class OutContainer, class Process>
+inline void batch_job_impl<InContainer, OutContainer, Process>::set_partitioning(batch_partitioning partitioning)
+{
+	assert(!is_enabled() && "Cannot change partitioning after enable has been called");
+
+	if (partitioning != batch_partitioning_guided || m_chunkEnds || !m_batchCount) {
+		return;
+	}
+
+	const std::size_t inputSize(m_input.size());
+	const std::size_t slices(to_batch_max_slices(m_target));
+	const std::size_t grain(to_guided_grain(slices));
+
+	std::size_t chunkCount(0);
+	for (std::size_t cursor = 0; cursor < inputSize; ++chunkCount) {
+		cursor += std::max<std::size_t>(grain, (inputSize - cursor) / slices);
+	}
+
+	tracker_allocator_type alloc;
+
+	if (m_batchTracker != m_inlineTracker.data()) {
+		alloc.deallocate(m_batchTracker, m_batchCount);
+	}
+
+	m_batchCount = (std::uint32_t)chunkCount;
+
+	if (BatchJobInlineSlices < m_batchCount) {
+		m_batchTracker = alloc.allocate(m_batchCount);
+		std::fill(m_batchTracker, m_batchTracker + m_batchCount, 0);
+	}
+	else {
+		m_batchTracker = m_inlineTracker.data();
+	}
+
+	chunk_allocator_type chunkAlloc;
+	m_chunkEnds = chunkAlloc.allocate(m_batchCount);
+
+	std::size_t cursor(0);
+	for (std::uint32_t i = 0; i < m_batchCount; ++i) {
+		cursor += std::max<std::size_t>(grain, (inputSize - cursor) / slices);
+		m_chunkEnds[i] = std::min<std::size_t>(cursor, inputSize);
+	}
+}
+template<class InContainer, class OutContainer, class Process>
 inline void batch_job_impl<InContainer, OutContainer, Process>::depends_on(job& dependency)
 {
 	m_root.depends_on(dependency);
@@ -233,6 +382,20 @@ inline void batch_job_impl<InContainer, OutContainer, Process>::work_until_ready
 	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
 }
 template<class InContainer, class OutContainer, class Process>
+inline void batch_job_impl<InContainer, OutContainer, Process>::cancel(bool cascade) noexcept
+{
+	if (cascade) {
+		_redirect_cancel_dependants(m_end.m_impl);
+	}
+
+	m_cancelled.store(true, std::memory_order_release);
+}
+template<class InContainer, class OutContainer, class Process>
+inline bool batch_job_impl<InContainer, OutContainer, Process>::is_cancelled() const noexcept
+{
+	return m_cancelled.load(std::memory_order_relaxed);
+}
+template<class InContainer, class OutContainer, class Process>
 inline bool batch_job_impl<InContainer, OutContainer, Process>::enable(const shared_ptr<batch_job_impl_interface>& selfRef) noexcept
 {
 	GDUL_JOB_DEBUG_CONDTIONAL(m_enqueueTimer.reset())
@@ -284,6 +447,16 @@ inline std::size_t batch_job_impl<InContainer, OutContainer, Process>::get_outpu
 	return m_batchTracker[m_batchCount - 1];
 }
 template<class InContainer, class OutContainer, class Process>
+inline const void* batch_job_impl<InContainer, OutContainer, Process>::get_result() const noexcept
+{
+	return nullptr;
+}
+template<class InContainer, class OutContainer, class Process>
+inline const void* batch_job_impl<InContainer, OutContainer, Process>::get_result_type() const noexcept
+{
+	return nullptr;
+}
+template<class InContainer, class OutContainer, class Process>
 template<class Fun>
 inline job batch_job_impl<InContainer, OutContainer, Process>::make_work_slice(Fun fun, std::size_t batchIndex, std::size_t variationId, const std::string_view& name)
 {
@@ -293,6 +466,11 @@ template<class InContainer, class OutContainer, class Process>
 template <class U, std::enable_if_t<U::SpecializeInput>*>
 inline void batch_job_impl<InContainer, OutContainer, Process>::work_process(std::size_t batchIndex)
 {
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		m_batchTracker[batchIndex] = 0;
+		return;
+	}
+
 	const std::size_t inputBegin(to_batch_begin(batchIndex));
 	const std::size_t inputEnd(to_batch_end(batchIndex));
 
@@ -318,6 +496,10 @@ template<class InContainer, class OutContainer, class Process>
 template <class U, std::enable_if_t<U::SpecializeUpdate>*>
 inline void batch_job_impl<InContainer, OutContainer, Process>::work_process(std::size_t batchIndex)
 {
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
 	const std::size_t inputBegin(to_batch_begin(batchIndex));
 	const std::size_t inputEnd(to_batch_end(batchIndex));
 
@@ -331,6 +513,11 @@ template<class InContainer, class OutContainer, class Process>
 template <class U, std::enable_if_t<U::SpecializeInputOutput>*>
 inline void batch_job_impl<InContainer, OutContainer, Process>::work_process(std::size_t batchIndex)
 {
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		m_batchTracker[batchIndex] = 0;
+		return;
+	}
+
 	const std::size_t inputBegin(to_batch_begin(batchIndex));
 	const std::size_t inputEnd(to_batch_end(batchIndex));
 	const std::size_t outputBegin(to_batch_begin(batchIndex));
@@ -352,55 +539,77 @@ inline void batch_job_impl<InContainer, OutContainer, Process>::work_process(std
 }
 template<class InContainer, class OutContainer, class Process>
 template <class U, std::enable_if_t<!U::SpecializeUpdate>*>
+inline job batch_job_impl<InContainer, OutContainer, Process>::make_process_sink()
+{
+	return make_work_slice(&batch_job_impl::work_scan, 0, 2, "Batch Job Scan");
+}
+template<class InContainer, class OutContainer, class Process>
+template <class U, std::enable_if_t<U::SpecializeUpdate>*>
+inline job batch_job_impl<InContainer, OutContainer, Process>::make_process_sink()
+{
+	return m_end;
+}
+template<class InContainer, class OutContainer, class Process>
 inline void batch_job_impl<InContainer, OutContainer, Process>::make_jobs()
 {
-	std::size_t variationCounter(2);
+	job sink(make_process_sink<>());
 
-	job currentProcessJob = make_work_slice(&batch_job_impl::work_process<>, 0, variationCounter++, "Batch Job Process");
+	std::size_t variationCounter(3);
 
-	std::invoke(m_enableFunc, &currentProcessJob);
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		job processJob(make_work_slice(&batch_job_impl::work_process<>, i, variationCounter++, "Batch Job Process"));
+
+		std::invoke(m_enableFunc, &processJob);
 
-	job currentPackJob(currentProcessJob);
+		sink.depends_on(processJob);
+	}
 
-	for (std::size_t i = 1; i < m_batchCount; ++i) {
-		job nextProcessJob(make_work_slice(&batch_job_impl::work_process<>, i, variationCounter++, "Batch Job Process"));
-		std::invoke(m_enableFunc, &nextProcessJob);
+	std::invoke(m_enableFunc, &sink);
+}
+template<class InContainer, class OutContainer, class Process>
+inline void batch_job_impl<InContainer, OutContainer, Process>::make_guided_jobs()
+{
+	const std::size_t runners(std::min<std::size_t>(m_batchCount, to_batch_max_slices(m_target)));
 
-		if (i < (m_batchCount - 1)) {
-			job nextPackJob(make_work_slice(&batch_job_impl::work_pack, i, variationCounter++, "Batch Job Pack"));
+	job sink(make_process_sink<>());
 
-			nextPackJob.depends_on(currentPackJob);
-			nextPackJob.depends_on(nextProcessJob);
-			std::invoke(m_enableFunc, &nextPackJob);
+	std::size_t variationCounter(3);
 
-			currentPackJob = std::move(nextPackJob);
-		}
+	for (std::size_t i = 0; i < runners; ++i) {
+		job runnerJob(make_work_slice(&batch_job_impl::work_guided, i, variationCounter++, "Batch Job Process"));
 
-		currentProcessJob = std::move(nextProcessJob);
-	}
+		std::invoke(m_enableFunc, &runnerJob);
 
-	if (1 < m_batchCount) {
-		m_end.depends_on(currentPackJob);
+		sink.depends_on(runnerJob);
 	}
 
-	m_end.depends_on(currentProcessJob);
-	std::invoke(m_enableFunc, &m_end);
+	std::invoke(m_enableFunc, &sink);
 }
 template<class InContainer, class OutContainer, class Process>
-template <class U, std::enable_if_t<U::SpecializeUpdate>*>
-inline void batch_job_impl<InContainer, OutContainer, Process>::make_jobs()
+inline void batch_job_impl<InContainer, OutContainer, Process>::work_guided(std::size_t)
 {
-	std::size_t variationCounter(2);
+	timer runnerTimer;
+	runnerTimer.start();
 
-	for (std::size_t i = 0; i < m_batchCount; ++i) {
-		job processJob(make_work_slice(&batch_job_impl::work_process<>, i, variationCounter++, "Batch Job Process"));
+	for (std::uint32_t chunk = m_chunkCursor.fetch_add(1, std::memory_order_relaxed); chunk < m_batchCount; chunk = m_chunkCursor.fetch_add(1, std::memory_order_relaxed)) {
+		work_process<>(chunk);
+	}
 
-		std::invoke(m_enableFunc, &processJob);
+	const float runtime(runnerTimer.elapsed());
 
-		m_end.depends_on(processJob);
+	float processTime(m_processTime.load(std::memory_order_relaxed));
+	while (!m_processTime.compare_exchange_weak(processTime, processTime + runtime, std::memory_order_relaxed));
+}
+template<class InContainer, class OutContainer, class Process>
+inline void batch_job_impl<InContainer, OutContainer, Process>::store_element_cost()
+{
+	if (!m_chunkEnds || m_cancelled.load(std::memory_order_relaxed)) {
+		return;
 	}
 
-	std::invoke(m_enableFunc, &m_end);
+	const std::size_t items(m_chunkEnds[m_batchCount - 1]);
+
+	m_info->store_element_cost(m_processTime.load(std::memory_order_relaxed) / (float)items);
 }
 template<class InContainer, class OutContainer, class Process>
 inline void batch_job_impl<InContainer, OutContainer, Process>::initialize()
@@ -412,36 +621,92 @@ inline void batch_job_impl<InContainer, OutContainer, Process>::initialize()
 
 	assert(!(m_output.size() < m_input.size()) && "Input container size must not exceed output container size");
 
-	make_jobs<>();
+	if (m_chunkEnds) {
+		make_guided_jobs();
+	}
+	else {
+		make_jobs();
+	}
 }
 template<class InContainer, class OutContainer, class Process>
-inline void batch_job_impl<InContainer, OutContainer, Process>::work_pack(std::size_t batchIndex)
+inline void batch_job_impl<InContainer, OutContainer, Process>::work_scan(std::size_t)
 {
-	const std::size_t outputBegin(to_batch_begin(batchIndex));
-	const std::size_t outputEnd(to_batch_end(batchIndex));
+	for (std::uint32_t i = 1; i < m_batchCount; ++i) {
+		m_batchTracker[i] += m_batchTracker[i - 1];
+	}
 
-	assert(outputBegin != 0 && "Illegal to pack batch#0");
-	assert(!(m_output.size() < outputEnd) && "End index out of bounds");
+	// Scatter jobs, indexed by slice. Null where a slice's output is already in place
+	job_vector_type scatterJobs(m_batchCount);
 
-	// Will never pack batch#0 
-	std::size_t lastBatchEnd(m_batchTracker[batchIndex - 1]);
-	const std::size_t batchSize(m_batchTracker[batchIndex]);
+	// Slice #0 is always in place
+	for (std::uint32_t i = 1; i < m_batchCount; ++i) {
+		const std::size_t targetBegin(m_batchTracker[i - 1]);
+		const std::size_t targetEnd(m_batchTracker[i]);
 
-	auto copyBeginItr(m_output.begin() + outputBegin);
-	auto copyEndItr(copyBeginItr + batchSize);
-	auto copyTargetItr(m_output.begin() + lastBatchEnd);
+		if (targetBegin == targetEnd || targetBegin == to_batch_begin(i)) {
+			continue;
+		}
 
-	std::move(copyBeginItr, copyEndItr, copyTargetItr);
+		job scatterJob(make_work_slice(&batch_job_impl::work_scatter, i, 3 + m_batchCount + i, "Batch Job Scatter"));
 
-	m_batchTracker[batchIndex] = (std::uint32_t)(lastBatchEnd + batchSize);
+		// Output moves towards the front, so the target range may only overlap the unmoved output of lower 
+		// slices. Find the first slice ending past the target range begin
+		std::uint32_t low(0);
+		std::uint32_t high(i);
+		while (low < high) {
+			const std::uint32_t mid(low + (high - low) / 2);
+
+			if (to_batch_end(mid) <= targetBegin) {
+				low = mid + 1;
+			}
+			else {
+				high = mid;
+			}
+		}
+
+		for (std::uint32_t j = low; j < i && to_batch_begin(j) < targetEnd; ++j) {
+			if (!scatterJobs[j]) {
+				continue;
+			}
+
+			const std::size_t sourceEnd(to_batch_begin(j) + (m_batchTracker[j] - m_batchTracker[j - 1]));
+
+			if (targetBegin < sourceEnd) {
+				scatterJob.depends_on(scatterJobs[j]);
+			}
+		}
+
+		std::invoke(m_enableFunc, &scatterJob);
+
+		m_end.depends_on(scatterJob);
+
+		scatterJobs[i] = std::move(scatterJob);
+	}
+
+	std::invoke(m_enableFunc, &m_end);
+}
+template<class InContainer, class OutContainer, class Process>
+inline void batch_job_impl<InContainer, OutContainer, Process>::work_scatter(std::size_t batchIndex)
+{
+	assert(batchIndex != 0 && "Illegal to scatter batch#0");
+
+	const std::size_t sourceBegin(to_batch_begin(batchIndex));
+	const std::size_t targetBegin(m_batchTracker[batchIndex - 1]);
+	const std::size_t items(m_batchTracker[batchIndex] - targetBegin);
+
+	assert(!(m_output.size() < sourceBegin + items) && "End index out of bounds");
+
+	auto copyBeginItr(m_output.begin() + sourceBegin);
+	auto copyEndItr(copyBeginItr + items);
+	auto copyTargetItr(m_output.begin() + targetBegin);
+
+	std::move(copyBeginItr, copyEndItr, copyTargetItr);
 }
 template<class InContainer, class OutContainer, class Process>
 template <class U, std::enable_if_t<!U::SpecializeUpdate>*>
 inline void batch_job_impl<InContainer, OutContainer, Process>::finalize()
 {
-	if (1 < m_batchCount) {
-		work_pack(m_batchCount - 1);
-	}
+	store_element_cost();
 
 	m_output.resize(get_output_size());
 
@@ -453,6 +718,8 @@ template<class InContainer, class OutContainer, class Process>
 template <class U, std::enable_if_t<U::SpecializeUpdate>*>
 inline void batch_job_impl<InContainer, OutContainer, Process>::finalize()
 {
+	store_element_cost();
+
 	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info)m_info->m_completionTimeSet.log_time(m_completionTimer.elapsed()))
 
 	const shared_ptr<batch_job_impl_interface> selfRef(m_selfRef.unsafe_exchange(shared_ptr<batch_job_impl_interface>(nullptr), std::memory_order_relaxed));
@@ -32,6 +32,16 @@ template <class T>
 class shared_ptr;
 class job;
 namespace jh_detail {
+
+// Address unique per type, checking batch job result types without rtti
+template <class T>
+const void* result_type_tag() noexcept
+{
+	// Not const, as identical constants may be folded into one
+	static char s_tag(0);
+	return &s_tag;
+}
+
 class batch_job_impl_interface
 {
 public:
@@ -45,9 +55,15 @@ public:
 	virtual void work_until_finished(job_queue*) = 0;
 	virtual void wait_until_ready() noexcept = 0;
 	virtual void work_until_ready(job_queue*) = 0;
+	virtual void set_partitioning(batch_partitioning) = 0;
+	virtual void cancel(bool) noexcept = 0;
+	virtual bool is_cancelled() const noexcept = 0;
 
 	virtual job& get_endjob() noexcept = 0;
 	virtual std::size_t get_output_size() const noexcept = 0;
+	virtual const void* get_result() const noexcept = 0;
+	// Null if the job has no result
+	virtual const void* get_result_type() const noexcept = 0;
 };
 }
 }
\ No newline at end of file
@@ -0,0 +1,230 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job/batch_job_graph_base.h>
+#include <gdul/execution/job_handler/globals.h>
+
+#include <gdul/utility/delegate.h>
+
+#include <vector>
+#include <algorithm>
+
+namespace gdul {
+
+namespace jh_detail {
+
+// Partitions each slice in place and counts its items satisfying the predicate. A scan over the counts then 
+// yields where each slice's leading and trailing items belong, which are scattered into a scratch buffer and moved back.
+// Like std::partition, relative order is not preserved. The result is the index of the first item not satisfying the predicate
+template <class Container, class Predicate>
+class batch_partition_job_impl : public batch_job_graph_base
+{
+public:
+	using container_type = Container;
+	using value_type = typename container_type::value_type;
+	using predicate_type = Predicate;
+
+	batch_partition_job_impl(Container& container, Predicate predicate, job_info* info, job_handler_impl* handler, job_queue* target);
+
+	const void* get_result() const noexcept override final;
+	const void* get_result_type() const noexcept override final;
+
+private:
+	using scratch_type = std::vector<value_type, typename std::allocator_traits<allocator_type>::template rebind_alloc<value_type>>;
+	using count_vector_type = std::vector<std::size_t, typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>>;
+
+	void build() override final;
+	void on_finalize() override final;
+
+	std::size_t to_slice_begin(std::size_t sliceIndex) const;
+
+	void work_partition_slice(std::size_t sliceIndex);
+	void work_scan();
+	void work_scatter(std::size_t sliceIndex);
+	void work_copy_back(std::size_t sliceIndex);
+	void work_join() {}
+
+	container_type& m_container;
+	predicate_type m_predicate;
+
+	scratch_type m_scratch;
+
+	// Per slice count of items satisfying the predicate, later their destination offset followed by that of the remaining items
+	count_vector_type m_counts;
+
+	std::size_t m_sliceCount;
+	std::size_t m_result;
+
+	bool m_skipMove;
+};
+
+template<class Container, class Predicate>
+inline batch_partition_job_impl<Container, Predicate>::batch_partition_job_impl(Container& container, Predicate predicate, job_info* info, job_handler_impl* handler, job_queue* target)
+	: batch_job_graph_base(info, handler, target)
+	, m_container(container)
+	, m_predicate(std::move(predicate))
+	, m_scratch()
+	, m_counts()
+	, m_sliceCount(1)
+	, m_result(0)
+	, m_skipMove(false)
+{
+}
+template<class Container, class Predicate>
+inline const void* batch_partition_job_impl<Container, Predicate>::get_result() const noexcept
+{
+	return &m_result;
+}
+template<class Container, class Predicate>
+inline const void* batch_partition_job_impl<Container, Predicate>::get_result_type() const noexcept
+{
+	return result_type_tag<std::size_t>();
+}
+template<class Container, class Predicate>
+inline void batch_partition_job_impl<Container, Predicate>::build()
+{
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	m_sliceCount = to_slice_count(m_container.size(), ParallelPartitionMinSliceItems);
+	m_counts.resize(m_sliceCount * 2);
+
+	job scan(make_graph_job(delegate<void()>(&batch_partition_job_impl::work_scan, this), "Partition Scan"));
+
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		job partitionJob(make_graph_job(delegate<void()>(&batch_partition_job_impl::work_partition_slice, this, i), "Partition Slice"));
+		enable_graph_job(partitionJob);
+
+		scan.depends_on(partitionJob);
+	}
+	enable_graph_job(scan);
+
+	if (m_sliceCount == 1) {
+		m_end.depends_on(scan);
+		return;
+	}
+
+	m_scratch.resize(m_container.size());
+
+	job join(make_graph_job(delegate<void()>(&batch_partition_job_impl::work_join, this), "Partition Join"));
+
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		job scatter(make_graph_job(delegate<void()>(&batch_partition_job_impl::work_scatter, this, i), "Partition Scatter"));
+		scatter.depends_on(scan);
+		enable_graph_job(scatter);
+
+		join.depends_on(scatter);
+	}
+	enable_graph_job(join);
+
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		job copyBack(make_graph_job(delegate<void()>(&batch_partition_job_impl::work_copy_back, this, i), "Partition Copy Back"));
+		copyBack.depends_on(join);
+		enable_graph_job(copyBack);
+
+		m_end.depends_on(copyBack);
+	}
+}
+template<class Container, class Predicate>
+inline void batch_partition_job_impl<Container, Predicate>::on_finalize()
+{
+	scratch_type().swap(m_scratch);
+}
+template<class Container, class Predicate>
+inline std::size_t batch_partition_job_impl<Container, Predicate>::to_slice_begin(std::size_t sliceIndex) const
+{
+	return (m_container.size() * sliceIndex) / m_sliceCount;
+}
+template<class Container, class Predicate>
+inline void batch_partition_job_impl<Container, Predicate>::work_partition_slice(std::size_t sliceIndex)
+{
+	m_counts[sliceIndex] = 0;
+
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	const auto begin(m_container.begin() + to_slice_begin(sliceIndex));
+	const auto end(m_container.begin() + to_slice_begin(sliceIndex + 1));
+
+	m_counts[sliceIndex] = (std::size_t)std::distance(begin, std::partition(begin, end, m_predicate));
+}
+template<class Container, class Predicate>
+inline void batch_partition_job_impl<Container, Predicate>::work_scan()
+{
+	std::size_t trueOffset(0);
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		trueOffset += m_counts[i];
+	}
+
+	m_result = trueOffset;
+
+	// Decided once, so that items are either moved in full or left in place
+	m_skipMove = m_cancelled.load(std::memory_order_acquire);
+
+	std::size_t falseOffset(trueOffset);
+	trueOffset = 0;
+
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		const std::size_t trueCount(m_counts[i]);
+		const std::size_t falseCount((to_slice_begin(i + 1) - to_slice_begin(i)) - trueCount);
+
+		m_counts[i] = trueOffset;
+		m_counts[m_sliceCount + i] = falseOffset;
+
+		trueOffset += trueCount;
+		falseOffset += falseCount;
+	}
+}
+template<class Container, class Predicate>
+inline void batch_partition_job_impl<Container, Predicate>::work_scatter(std::size_t sliceIndex)
+{
+	if (m_skipMove) {
+		return;
+	}
+
+	const std::size_t begin(to_slice_begin(sliceIndex));
+	const std::size_t end(to_slice_begin(sliceIndex + 1));
+	const std::size_t trueOffset(m_counts[sliceIndex]);
+	const std::size_t falseOffset(m_counts[m_sliceCount + sliceIndex]);
+	const std::size_t sliceTrueCount((sliceIndex + 1 < m_sliceCount ? m_counts[sliceIndex + 1] : m_result) - trueOffset);
+
+	auto src(m_container.begin() + begin);
+
+	std::move(src, src + sliceTrueCount, m_scratch.begin() + trueOffset);
+	std::move(src + sliceTrueCount, src + (end - begin), m_scratch.begin() + falseOffset);
+}
+template<class Container, class Predicate>
+inline void batch_partition_job_impl<Container, Predicate>::work_copy_back(std::size_t sliceIndex)
+{
+	if (m_skipMove) {
+		return;
+	}
+
+	const std::size_t begin(to_slice_begin(sliceIndex));
+	const std::size_t end(to_slice_begin(sliceIndex + 1));
+
+	std::move(m_scratch.begin() + begin, m_scratch.begin() + end, m_container.begin() + begin);
+}
+}
+}
@@ -0,0 +1,143 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job/batch_job_graph_base.h>
+
+#include <gdul/utility/delegate.h>
+
+#include <type_traits>
+#include <algorithm>
+#include <cassert>
+
+namespace gdul {
+
+namespace jh_detail {
+
+using range_kernel_type = delegate<void(std::size_t, std::size_t)>;
+using tile_kernel_type = delegate<void(const batch_tile&)>;
+
+// Splits an index space over jobs, handing the kernel whole sub ranges rather than single elements. 
+// Tiles are ordered x first and each job is given a contiguous run of them. For one dimensional
+// ranges each job's run is handed to the kernel as a single [begin, end) call
+template <class Kernel>
+class batch_range_job_impl : public batch_job_graph_base
+{
+public:
+	static_assert(std::is_same_v<Kernel, range_kernel_type> || std::is_same_v<Kernel, tile_kernel_type>, "Unsupported range kernel");
+
+	batch_range_job_impl(std::size_t offset, const batch_grid& grid, Kernel&& kernel, job_info* info, job_handler_impl* handler, job_queue* target);
+
+private:
+	static constexpr bool IsRange = std::is_same_v<Kernel, range_kernel_type>;
+
+	void build() override final;
+
+	void work_tiles(std::size_t firstTile, std::size_t lastTile);
+
+	Kernel m_kernel;
+
+	batch_grid m_grid;
+
+	std::size_t m_offset;
+	std::size_t m_tilesX;
+	std::size_t m_tilesY;
+};
+
+template<class Kernel>
+inline batch_range_job_impl<Kernel>::batch_range_job_impl(std::size_t offset, const batch_grid& grid, Kernel&& kernel, job_info* info, job_handler_impl* handler, job_queue* target)
+	: batch_job_graph_base(info, handler, target)
+	, m_kernel(std::move(kernel))
+	, m_grid(grid)
+	, m_offset(offset)
+	, m_tilesX(0)
+	, m_tilesY(0)
+{
+	assert(m_grid.tileX && m_grid.tileY && m_grid.tileZ && "Tile size may not be zero");
+}
+template<class Kernel>
+inline void batch_range_job_impl<Kernel>::build()
+{
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	if constexpr (IsRange) {
+		// One tile per job
+		const std::size_t slices(to_slice_count(m_grid.sizeX, 1));
+		m_grid.tileX = std::max<std::size_t>(m_grid.sizeX / slices + (bool)(m_grid.sizeX % slices), 1);
+	}
+
+	m_tilesX = m_grid.sizeX / m_grid.tileX + (bool)(m_grid.sizeX % m_grid.tileX);
+	m_tilesY = m_grid.sizeY / m_grid.tileY + (bool)(m_grid.sizeY % m_grid.tileY);
+	const std::size_t tilesZ(m_grid.sizeZ / m_grid.tileZ + (bool)(m_grid.sizeZ % m_grid.tileZ));
+
+	const std::size_t tiles(m_tilesX * m_tilesY * tilesZ);
+
+	if (!tiles) {
+		return;
+	}
+
+	const std::size_t slices(to_slice_count(tiles, 1));
+
+	for (std::size_t i = 0; i < slices; ++i) {
+		const std::size_t firstTile((tiles * i) / slices);
+		const std::size_t lastTile((tiles * (i + 1)) / slices);
+
+		job rangeJob(make_graph_job(delegate<void()>(&batch_range_job_impl::work_tiles, this, firstTile, lastTile), "Range Process"));
+		enable_graph_job(rangeJob);
+
+		m_end.depends_on(rangeJob);
+	}
+}
+template<class Kernel>
+inline void batch_range_job_impl<Kernel>::work_tiles(std::size_t firstTile, std::size_t lastTile)
+{
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	if constexpr (IsRange) {
+		const std::size_t begin(firstTile * m_grid.tileX);
+		const std::size_t end(std::min(lastTile * m_grid.tileX, m_grid.sizeX));
+
+		m_kernel(m_offset + begin, m_offset + end);
+	}
+	else {
+		for (std::size_t tile = firstTile; tile < lastTile; ++tile) {
+			const std::size_t x(tile % m_tilesX);
+			const std::size_t y((tile / m_tilesX) % m_tilesY);
+			const std::size_t z(tile / (m_tilesX * m_tilesY));
+
+			batch_tile bounds;
+			bounds.beginX = x * m_grid.tileX;
+			bounds.endX = std::min(bounds.beginX + m_grid.tileX, m_grid.sizeX);
+			bounds.beginY = y * m_grid.tileY;
+			bounds.endY = std::min(bounds.beginY + m_grid.tileY, m_grid.sizeY);
+			bounds.beginZ = z * m_grid.tileZ;
+			bounds.endZ = std::min(bounds.beginZ + m_grid.tileZ, m_grid.sizeZ);
+
+			m_kernel(bounds);
+		}
+	}
+}
+}
+}
@@ -0,0 +1,359 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#include <gdul/execution/job_handler/job/batch_job_impl.h>
+
+#include <functional>
+#include <vector>
+
+namespace gdul {
+
+namespace jh_detail {
+
+template <class Result>
+struct alignas(64) batch_reduce_partial
+{
+	Result m_value;
+};
+
+// Splits input over a number of slices, each mapping and combining its items into a padded partial result. 
+// Partials are then combined pairwise as a tree of jobs, leaving the final result in the first partial
+template <class InContainer, class Result>
+class batch_reduce_job_impl : public batch_job_impl_interface
+{
+public:
+	using intput_container_type = InContainer;
+	using ref_input_type = typename intput_container_type::value_type&;
+	using result_type = Result;
+	using map_type = delegate<Result(ref_input_type)>;
+	using combine_type = delegate<Result(const Result&, const Result&)>;
+
+	batch_reduce_job_impl(InContainer& input, const Result& identity, map_type&& map, combine_type&& combine, job_info* info, job_handler_impl* handler, job_queue* target);
+	~batch_reduce_job_impl();
+
+	void depends_on(job& dependency) override final;
+
+	void wait_until_finished() noexcept override final;
+	void wait_until_ready() noexcept override final;
+	void work_until_finished(job_queue* consumeFrom) override final;
+	void work_until_ready(job_queue* consumeFrom) override final;
+
+	// Reduce jobs are always partitioned statically
+	void set_partitioning(batch_partitioning partitioning) override final;
+
+	void cancel(bool cascade) noexcept override final;
+	bool is_cancelled() const noexcept override final;
+
+	bool enable(const shared_ptr<batch_job_impl_interface>& selfRef)  noexcept override final;
+	bool enable_locally_if_ready() override final;
+
+	bool is_enabled() const noexcept override final;
+	bool is_finished() const noexcept override final;
+	bool is_ready() const noexcept override final;
+
+	job& get_endjob() noexcept override final;
+
+	std::size_t get_output_size() const noexcept override final;
+
+	const void* get_result() const noexcept override final;
+	const void* get_result_type() const noexcept override final;
+
+private:
+	using partial_type = batch_reduce_partial<Result>;
+	using partial_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<partial_type>;
+	using job_vector_type = std::vector<job, typename std::allocator_traits<allocator_type>::template rebind_alloc<job>>;
+
+	std::size_t to_batch_begin(std::size_t batchIndex) const;
+	std::size_t to_batch_end(std::size_t batchIndex) const;
+
+	void work_process(std::size_t batchIndex);
+	void work_combine(std::size_t batchIndex, std::size_t stride);
+
+	void make_jobs();
+
+	void initialize();
+	void finalize();
+
+	job_info* m_info;
+
+	GDUL_JOB_DEBUG_CONDTIONAL(timer m_completionTimer)
+	GDUL_JOB_DEBUG_CONDTIONAL(timer m_enqueueTimer)
+
+	partial_type* m_partials;
+
+	map_type m_map;
+	combine_type m_combine;
+
+	job_handler_impl* const m_handler;
+	job_queue* const m_target;
+
+	bool (job::* m_enableFunc)(void);
+
+	intput_container_type& m_input;
+
+	const std::uint32_t m_batchCount;
+	const std::size_t m_batchSize;
+
+	std::atomic_bool m_cancelled;
+
+	atomic_shared_ptr<batch_job_impl_interface> m_selfRef;
+
+	job m_root;
+	job m_end;
+};
+template<class InContainer, class Result>
+inline batch_reduce_job_impl<InContainer, Result>::batch_reduce_job_impl(InContainer& input, const Result& identity, map_type&& map, combine_type&& combine, job_info* info, job_handler_impl* handler, job_queue* target)
+	: m_info(info)
+	, m_partials(nullptr)
+	, m_map(std::move(map))
+	, m_combine(std::move(combine))
+	, m_handler(handler)
+	, m_target(target)
+	, m_enableFunc(&job::enable)
+	, m_input(input)
+	, m_batchCount((std::uint32_t)std::max<std::size_t>(std::min<std::size_t>(input.size(), to_batch_max_slices(target)), 1))
+	, m_batchSize(input.size() / m_batchCount + ((bool)(input.size() % m_batchCount)))
+	, m_cancelled(false)
+	, m_selfRef()
+	, m_root(_redirect_make_job(handler, delegate<void()>(&batch_reduce_job_impl::initialize, this), target, m_info->id(), 0, "Reduce Initialize"))
+	, m_end(_redirect_make_job(handler, delegate<void()>(&batch_reduce_job_impl::finalize, this), target, m_info->id(), 1, "Reduce Finalize"))
+{
+	partial_allocator_type alloc;
+	m_partials = alloc.allocate(m_batchCount);
+
+	for (std::uint32_t i = 0; i < m_batchCount; ++i) {
+		new (&m_partials[i]) partial_type{ identity };
+	}
+
+#if defined (GDUL_JOB_DEBUG)
+	m_info->set_job_type(job_type::job_batch);
+#endif
+}
+template<class InContainer, class Result>
+inline batch_reduce_job_impl<InContainer, Result>::~batch_reduce_job_impl()
+{
+	assert(_redirect_is_enabled(m_root.m_impl) && "Job destructor ran before enable was called");
+
+	for (std::uint32_t i = 0; i < m_batchCount; ++i) {
+		m_partials[i].~partial_type();
+	}
+
+	partial_allocator_type alloc;
+	alloc.deallocate(m_partials, m_batchCount);
+}
+template<class InContainer, class Result>
+inline std::size_t batch_reduce_job_impl<InContainer, Result>::to_batch_begin(std::size_t batchIndex) const
+{
+	return std::min<std::size_t>(batchIndex * m_batchSize, m_input.size());
+}
+template<class InContainer, class Result>
+inline std::size_t batch_reduce_job_impl<InContainer, Result>::to_batch_end(std::size_t batchIndex) const
+{
+	return std::min<std::size_t>(batchIndex * m_batchSize + m_batchSize, m_input.size());
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::depends_on(job& dependency)
+{
+	m_root.depends_on(dependency);
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::wait_until_finished() noexcept
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_end.wait_until_finished();
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::wait_until_ready() noexcept
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_root.wait_until_ready();
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::work_until_finished(job_queue* consumeFrom)
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_end.work_until_finished(consumeFrom);
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::work_until_ready(job_queue* consumeFrom)
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(timer waitTimer)
+	m_root.work_until_ready(consumeFrom);
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info) m_info->m_waitTimeSet.log_time(waitTimer.elapsed()))
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::set_partitioning(batch_partitioning)
+{
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::cancel(bool cascade) noexcept
+{
+	if (cascade) {
+		_redirect_cancel_dependants(m_end.m_impl);
+	}
+
+	m_cancelled.store(true, std::memory_order_release);
+}
+template<class InContainer, class Result>
+inline bool batch_reduce_job_impl<InContainer, Result>::is_cancelled() const noexcept
+{
+	return m_cancelled.load(std::memory_order_relaxed);
+}
+template<class InContainer, class Result>
+inline bool batch_reduce_job_impl<InContainer, Result>::enable(const shared_ptr<batch_job_impl_interface>& selfRef) noexcept
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(m_enqueueTimer.reset())
+
+	const bool result(m_root.enable());
+	if (result) {
+		raw_ptr<batch_job_impl_interface> expected(nullptr);
+		m_selfRef.compare_exchange_strong(expected, selfRef, std::memory_order_relaxed);
+	}
+
+	return result;
+}
+template<class InContainer, class Result>
+inline bool batch_reduce_job_impl<InContainer, Result>::enable_locally_if_ready()
+{
+	if (_redirect_enable_if_ready(m_root.m_impl)) {
+
+		GDUL_JOB_DEBUG_CONDTIONAL(m_enqueueTimer.reset())
+
+		m_enableFunc = &job::enable_locally_if_ready;
+		_redirect_invoke_job(m_root.m_impl);
+		return true;
+	}
+	return false;
+}
+template<class InContainer, class Result>
+inline bool batch_reduce_job_impl<InContainer, Result>::is_enabled() const noexcept
+{
+	return _redirect_is_enabled(m_root.m_impl);
+}
+template<class InContainer, class Result>
+inline bool batch_reduce_job_impl<InContainer, Result>::is_finished() const noexcept
+{
+	return m_end.is_finished();
+}
+template<class InContainer, class Result>
+inline bool batch_reduce_job_impl<InContainer, Result>::is_ready() const noexcept
+{
+	return m_root.is_ready();
+}
+template<class InContainer, class Result>
+inline job& batch_reduce_job_impl<InContainer, Result>::get_endjob() noexcept
+{
+	return m_end;
+}
+template<class InContainer, class Result>
+inline std::size_t batch_reduce_job_impl<InContainer, Result>::get_output_size() const noexcept
+{
+	return 0;
+}
+template<class InContainer, class Result>
+inline const void* batch_reduce_job_impl<InContainer, Result>::get_result() const noexcept
+{
+	return &m_partials[0].m_value;
+}
+template<class InContainer, class Result>
+inline const void* batch_reduce_job_impl<InContainer, Result>::get_result_type() const noexcept
+{
+	return result_type_tag<Result>();
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::work_process(std::size_t batchIndex)
+{
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	const std::size_t inputBegin(to_batch_begin(batchIndex));
+	const std::size_t inputEnd(to_batch_end(batchIndex));
+
+	// Accumulate locally, keeping the shared partial out of the loop
+	Result accumulator(m_partials[batchIndex].m_value);
+
+	for (std::size_t i = inputBegin; i < inputEnd; ++i) {
+		ref_input_type inputRef(*(m_input.begin() + i));
+
+		accumulator = m_combine(accumulator, m_map(inputRef));
+	}
+
+	m_partials[batchIndex].m_value = std::move(accumulator);
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::work_combine(std::size_t batchIndex, std::size_t stride)
+{
+	m_partials[batchIndex].m_value = m_combine(m_partials[batchIndex].m_value, m_partials[batchIndex + stride].m_value);
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::make_jobs()
+{
+	std::size_t variationCounter(2);
+
+	// Last job to have written each partial
+	job_vector_type producers(m_batchCount);
+
+	for (std::size_t i = 0; i < m_batchCount; ++i) {
+		producers[i] = _redirect_make_job(m_handler, delegate<void()>(&batch_reduce_job_impl::work_process, this, i), m_target, m_info->id(), variationCounter++, "Reduce Process");
+		std::invoke(m_enableFunc, &producers[i]);
+	}
+
+	for (std::size_t stride = 1; stride < m_batchCount; stride *= 2) {
+		for (std::size_t i = 0; i + stride < m_batchCount; i += stride * 2) {
+			job combineJob(_redirect_make_job(m_handler, delegate<void()>(&batch_reduce_job_impl::work_combine, this, i, stride), m_target, m_info->id(), variationCounter++, "Reduce Combine"));
+
+			combineJob.depends_on(producers[i]);
+			combineJob.depends_on(producers[i + stride]);
+			std::invoke(m_enableFunc, &combineJob);
+
+			producers[i] = std::move(combineJob);
+		}
+	}
+
+	m_end.depends_on(producers[0]);
+	std::invoke(m_enableFunc, &m_end);
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::initialize()
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(m_completionTimer.reset())
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info)m_info->m_enqueueTimeSet.log_time(m_enqueueTimer.elapsed()))
+
+	make_jobs();
+}
+template<class InContainer, class Result>
+inline void batch_reduce_job_impl<InContainer, Result>::finalize()
+{
+	GDUL_JOB_DEBUG_CONDTIONAL(if (m_info)m_info->m_completionTimeSet.log_time(m_completionTimer.elapsed()))
+
+	const shared_ptr<batch_job_impl_interface> selfRef(m_selfRef.unsafe_exchange(shared_ptr<batch_job_impl_interface>(nullptr), std::memory_order_relaxed));
+}
+}
+}
+#pragma warning(pop)
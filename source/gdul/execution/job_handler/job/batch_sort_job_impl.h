@@ -0,0 +1,435 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job/batch_job_graph_base.h>
+#include <gdul/execution/job_handler/globals.h>
+
+#include <gdul/utility/delegate.h>
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#include <climits>
+
+namespace gdul {
+
+namespace jh_detail {
+
+// Integer keys compared by std::less are sorted by least significant digit radix passes instead of comparisons
+template <class T, class Compare>
+constexpr bool is_radix_sortable_v =
+	std::is_integral_v<T> &&
+	!std::is_same_v<T, bool> &&
+	(std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>);
+
+// Sorts each slice of the container, after which sorted runs are merged pairwise level by level. Each 
+// merge is split evenly over as many jobs as there are slices by searching for the split points along the merge path.
+// The split points of a run are all searched ahead of its merge jobs, since these move items out of the runs searched.
+// Levels alternate between the container and a scratch buffer, so an odd level count ends with a copy back.
+// Radix sortable keys instead run one histogram -> scan -> scatter pass per key byte.
+// Cancellation is observed before the graph is built. Once items are in flight the sort runs to completion
+template <class Container, class Compare>
+class batch_sort_job_impl : public batch_job_graph_base
+{
+public:
+	using container_type = Container;
+	using value_type = typename container_type::value_type;
+	using compare_type = Compare;
+
+	batch_sort_job_impl(Container& container, Compare compare, job_info* info, job_handler_impl* handler, job_queue* target);
+
+private:
+	static constexpr bool UseRadix = is_radix_sortable_v<value_type, compare_type>;
+	static constexpr std::size_t RadixBits = 8;
+	static constexpr std::size_t RadixBuckets = std::size_t(1) << RadixBits;
+	static constexpr std::size_t RadixPasses = sizeof(value_type);
+
+	using iterator_type = typename container_type::iterator;
+	using scratch_type = std::vector<value_type, typename std::allocator_traits<allocator_type>::template rebind_alloc<value_type>>;
+	using count_vector_type = std::vector<std::size_t, typename std::allocator_traits<allocator_type>::template rebind_alloc<std::size_t>>;
+	using job_vector_type = std::vector<job, typename std::allocator_traits<allocator_type>::template rebind_alloc<job>>;
+
+	void build() override final;
+	void on_finalize() override final;
+
+	std::size_t to_slice_begin(std::size_t sliceIndex) const;
+
+	void build_merge(job_vector_type& producers);
+	void build_radix(job_vector_type& producers);
+	void build_copy_back(job_vector_type& producers);
+
+	void work_sort_slice(std::size_t sliceIndex);
+
+	// Stores the number of left run items preceding each part of the output run in m_counts
+	void work_merge_split(std::size_t level, std::size_t firstSlice, std::size_t runSlices);
+
+	// Merges part of the output run, between the split points found by work_merge_split
+	void work_merge(std::size_t level, std::size_t firstSlice, std::size_t runSlices, std::size_t part);
+
+	void work_histogram(std::size_t pass, std::size_t sliceIndex);
+	void work_radix_scan();
+	void work_radix_scatter(std::size_t pass, std::size_t sliceIndex);
+
+	void work_copy_back(std::size_t sliceIndex);
+	void work_join() {}
+
+	// Number of elements taken from the left run in the first k elements of the merged output
+	template <class It>
+	std::size_t co_rank(It left, std::size_t leftSize, It right, std::size_t rightSize, std::size_t k) const;
+
+	static std::size_t to_digit(const value_type& item, std::size_t pass);
+
+	container_type& m_container;
+	compare_type m_compare;
+
+	scratch_type m_scratch;
+	count_vector_type m_counts;
+
+	std::size_t m_sliceCount;
+};
+
+template<class Container, class Compare>
+inline batch_sort_job_impl<Container, Compare>::batch_sort_job_impl(Container& container, Compare compare, job_info* info, job_handler_impl* handler, job_queue* target)
+	: batch_job_graph_base(info, handler, target)
+	, m_container(container)
+	, m_compare(std::move(compare))
+	, m_scratch()
+	, m_counts()
+	, m_sliceCount(1)
+{
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::build()
+{
+	if (m_cancelled.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	const std::size_t items(m_container.size());
+	const std::size_t slices(to_slice_count(items, ParallelSortMinSliceItems));
+
+	// Merging requires a power of two number of runs
+	m_sliceCount = 1;
+	while (m_sliceCount * 2 <= slices) {
+		m_sliceCount *= 2;
+	}
+
+	job_vector_type producers(m_sliceCount);
+
+	if (m_sliceCount == 1) {
+		producers[0] = make_graph_job(delegate<void()>(&batch_sort_job_impl::work_sort_slice, this, std::size_t(0)), "Sort Slice");
+		enable_graph_job(producers[0]);
+	}
+	else {
+		m_scratch.resize(items);
+
+		if constexpr (UseRadix) {
+			build_radix(producers);
+		}
+		else {
+			build_merge(producers);
+		}
+	}
+
+	for (job& producer : producers) {
+		m_end.depends_on(producer);
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::on_finalize()
+{
+	scratch_type().swap(m_scratch);
+	count_vector_type().swap(m_counts);
+}
+template<class Container, class Compare>
+inline std::size_t batch_sort_job_impl<Container, Compare>::to_slice_begin(std::size_t sliceIndex) const
+{
+	return (m_scratch.size() * sliceIndex) / m_sliceCount;
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::build_merge(job_vector_type& producers)
+{
+	// One split point per slice. A run only reuses those of its own slices, once their previous level is merged
+	m_counts.resize(m_sliceCount);
+
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		producers[i] = make_graph_job(delegate<void()>(&batch_sort_job_impl::work_sort_slice, this, i), "Sort Slice");
+		enable_graph_job(producers[i]);
+	}
+
+	std::size_t level(0);
+
+	// producers[run] holds the job finishing the run, each level halving the number of runs
+	for (std::size_t runSlices = 2; runSlices <= m_sliceCount; runSlices *= 2, ++level) {
+		for (std::size_t run = 0; run < m_sliceCount / runSlices; ++run) {
+			const std::size_t firstSlice(run * runSlices);
+
+			job split(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_merge_split, this, level, firstSlice, runSlices), "Sort Merge Split"));
+			split.depends_on(producers[run * 2]);
+			split.depends_on(producers[run * 2 + 1]);
+			enable_graph_job(split);
+
+			job join(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_join, this), "Sort Merge Join"));
+
+			for (std::size_t part = 0; part < runSlices; ++part) {
+				job mergeJob(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_merge, this, level, firstSlice, runSlices, part), "Sort Merge"));
+				mergeJob.depends_on(split);
+				enable_graph_job(mergeJob);
+
+				join.depends_on(mergeJob);
+			}
+
+			enable_graph_job(join);
+
+			producers[run] = std::move(join);
+		}
+	}
+
+	producers.resize(1);
+
+	if (level % 2) {
+		build_copy_back(producers);
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::build_radix(job_vector_type& producers)
+{
+	m_counts.resize(m_sliceCount * RadixBuckets);
+
+	job passJoin;
+
+	for (std::size_t pass = 0; pass < RadixPasses; ++pass) {
+		job scan(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_radix_scan, this), "Sort Radix Scan"));
+		job join(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_join, this), "Sort Radix Join"));
+
+		for (std::size_t i = 0; i < m_sliceCount; ++i) {
+			job histogram(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_histogram, this, pass, i), "Sort Radix Histogram"));
+			if (passJoin) {
+				histogram.depends_on(passJoin);
+			}
+			enable_graph_job(histogram);
+
+			scan.depends_on(histogram);
+		}
+		enable_graph_job(scan);
+
+		for (std::size_t i = 0; i < m_sliceCount; ++i) {
+			job scatter(make_graph_job(delegate<void()>(&batch_sort_job_impl::work_radix_scatter, this, pass, i), "Sort Radix Scatter"));
+			scatter.depends_on(scan);
+			enable_graph_job(scatter);
+
+			join.depends_on(scatter);
+		}
+		enable_graph_job(join);
+
+		passJoin = std::move(join);
+	}
+
+	producers.resize(1);
+	producers[0] = std::move(passJoin);
+
+	if (RadixPasses % 2) {
+		build_copy_back(producers);
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::build_copy_back(job_vector_type& producers)
+{
+	job last(std::move(producers[0]));
+
+	producers.resize(m_sliceCount);
+
+	for (std::size_t i = 0; i < m_sliceCount; ++i) {
+		producers[i] = make_graph_job(delegate<void()>(&batch_sort_job_impl::work_copy_back, this, i), "Sort Copy Back");
+		producers[i].depends_on(last);
+		enable_graph_job(producers[i]);
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_sort_slice(std::size_t sliceIndex)
+{
+	const std::size_t items(m_container.size());
+	const std::size_t begin((items * sliceIndex) / m_sliceCount);
+	const std::size_t end((items * (sliceIndex + 1)) / m_sliceCount);
+
+	std::sort(m_container.begin() + begin, m_container.begin() + end, m_compare);
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_merge_split(std::size_t level, std::size_t firstSlice, std::size_t runSlices)
+{
+	const std::size_t runBegin(to_slice_begin(firstSlice));
+	const std::size_t runMid(to_slice_begin(firstSlice + runSlices / 2));
+	const std::size_t runEnd(to_slice_begin(firstSlice + runSlices));
+
+	auto split = [this, firstSlice, runSlices, runBegin, runMid, runEnd](auto src) {
+		for (std::size_t part = 0; part < runSlices; ++part) {
+			const std::size_t outBegin(to_slice_begin(firstSlice + part));
+
+			m_counts[firstSlice + part] = co_rank(src + runBegin, runMid - runBegin, src + runMid, runEnd - runMid, outBegin - runBegin);
+		}
+	};
+
+	if (level % 2) {
+		split(m_scratch.begin());
+	}
+	else {
+		split(m_container.begin());
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_merge(std::size_t level, std::size_t firstSlice, std::size_t runSlices, std::size_t part)
+{
+	const std::size_t runBegin(to_slice_begin(firstSlice));
+	const std::size_t runMid(to_slice_begin(firstSlice + runSlices / 2));
+	const std::size_t runEnd(to_slice_begin(firstSlice + runSlices));
+	const std::size_t outBegin(to_slice_begin(firstSlice + part));
+	const std::size_t outEnd(to_slice_begin(firstSlice + part + 1));
+
+	const std::size_t leftFrom(m_counts[firstSlice + part]);
+	const std::size_t leftTo(part + 1 < runSlices ? m_counts[firstSlice + part + 1] : runMid - runBegin);
+	const std::size_t rightFrom((outBegin - runBegin) - leftFrom);
+	const std::size_t rightTo((outEnd - runBegin) - leftTo);
+
+	auto merge = [this, runBegin, runMid, outBegin, leftFrom, leftTo, rightFrom, rightTo](auto src, auto dst) {
+		std::merge(
+			std::make_move_iterator(src + runBegin + leftFrom), std::make_move_iterator(src + runBegin + leftTo),
+			std::make_move_iterator(src + runMid + rightFrom), std::make_move_iterator(src + runMid + rightTo),
+			dst + outBegin,
+			m_compare);
+	};
+
+	if (level % 2) {
+		merge(m_scratch.begin(), m_container.begin());
+	}
+	else {
+		merge(m_container.begin(), m_scratch.begin());
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_histogram(std::size_t pass, std::size_t sliceIndex)
+{
+	std::size_t* const counts(&m_counts[sliceIndex * RadixBuckets]);
+	std::fill(counts, counts + RadixBuckets, std::size_t(0));
+
+	const std::size_t begin(to_slice_begin(sliceIndex));
+	const std::size_t end(to_slice_begin(sliceIndex + 1));
+
+	auto count = [counts, begin, end, pass](auto src) {
+		for (std::size_t i = begin; i < end; ++i) {
+			++counts[to_digit(*(src + i), pass)];
+		}
+	};
+
+	if (pass % 2) {
+		count(m_scratch.begin());
+	}
+	else {
+		count(m_container.begin());
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_radix_scan()
+{
+	// Bucket major, slice minor, so that each slice scatters its bucket items after those of lower slices
+	std::size_t offset(0);
+	for (std::size_t bucket = 0; bucket < RadixBuckets; ++bucket) {
+		for (std::size_t i = 0; i < m_sliceCount; ++i) {
+			const std::size_t count(m_counts[i * RadixBuckets + bucket]);
+			m_counts[i * RadixBuckets + bucket] = offset;
+			offset += count;
+		}
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_radix_scatter(std::size_t pass, std::size_t sliceIndex)
+{
+	std::size_t* const offsets(&m_counts[sliceIndex * RadixBuckets]);
+
+	const std::size_t begin(to_slice_begin(sliceIndex));
+	const std::size_t end(to_slice_begin(sliceIndex + 1));
+
+	auto scatter = [offsets, begin, end, pass](auto src, auto dst) {
+		for (std::size_t i = begin; i < end; ++i) {
+			auto& item(*(src + i));
+			*(dst + offsets[to_digit(item, pass)]++) = std::move(item);
+		}
+	};
+
+	if (pass % 2) {
+		scatter(m_scratch.begin(), m_container.begin());
+	}
+	else {
+		scatter(m_container.begin(), m_scratch.begin());
+	}
+}
+template<class Container, class Compare>
+inline void batch_sort_job_impl<Container, Compare>::work_copy_back(std::size_t sliceIndex)
+{
+	const std::size_t begin(to_slice_begin(sliceIndex));
+	const std::size_t end(to_slice_begin(sliceIndex + 1));
+
+	std::move(m_scratch.begin() + begin, m_scratch.begin() + end, m_container.begin() + begin);
+}
+template<class Container, class Compare>
+template<class It>
+inline std::size_t batch_sort_job_impl<Container, Compare>::co_rank(It left, std::size_t leftSize, It right, std::size_t rightSize, std::size_t k) const
+{
+	std::size_t low(rightSize < k ? k - rightSize : 0);
+	std::size_t high(std::min(k, leftSize));
+
+	// Equal items are taken from the left run first, keeping the merge stable
+	while (low < high) {
+		const std::size_t i(low + (high - low) / 2);
+		const std::size_t j(k - i);
+
+		if (0 < j && !m_compare(*(right + (j - 1)), *(left + i))) {
+			low = i + 1;
+		}
+		else {
+			high = i;
+		}
+	}
+
+	return low;
+}
+template<class Container, class Compare>
+inline std::size_t batch_sort_job_impl<Container, Compare>::to_digit(const value_type& item, std::size_t pass)
+{
+	if constexpr (UseRadix) {
+		using key_type = std::make_unsigned_t<value_type>;
+
+		// Flip sign bit so that negative keys order before positive ones
+		constexpr key_type signFlip(std::is_signed_v<value_type> ? key_type(key_type(1) << (sizeof(key_type) * CHAR_BIT - 1)) : key_type(0));
+
+		const key_type key(key_type(static_cast<key_type>(item) ^ signFlip));
+
+		return std::size_t((key >> (pass * RadixBits)) & (RadixBuckets - 1));
+	}
+	else {
+		item; pass;
+		return 0;
+	}
+}
+}
+}
@@ -27,7 +27,7 @@
 #include <gdul/execution/job_handler/job_queue.h>
 
 namespace gdul {
-thread_local job job::this_job(shared_ptr<jh_detail::job_impl>(nullptr));
+thread_local job job::this_job(jh_detail::job_impl_ptr(nullptr));
 
 job::job() noexcept
 {
@@ -68,6 +68,22 @@ void job::depends_on(batch_job& dependency)
 {
 	depends_on(dependency.get_endjob());
 }
+job job::then(delegate<void()> workUnit, const std::string_view& dbgName)
+{
+	assert(m_impl && "Cannot continue from null job");
+
+	return then(std::move(workUnit), m_impl->get_target(), dbgName);
+}
+job job::then(delegate<void()> workUnit, job_queue* target, const std::string_view& dbgName)
+{
+	assert(m_impl && "Cannot continue from null job");
+
+	job continuation(m_impl->make_continuation(std::move(workUnit), target, dbgName));
+	continuation.depends_on(*this);
+	continuation.enable();
+
+	return continuation;
+}
 
 bool job::enable() noexcept
 {
@@ -82,6 +98,34 @@ bool job::enable() noexcept
 	}
 	return false;
 }
+bool job::enable_at(std::chrono::steady_clock::time_point deadline) noexcept
+{
+	if (!m_impl) {
+		return false;
+	}
+
+	// Held by the timer queue, and released as the deadline passes
+	if (!m_impl->try_add_dependencies(1)) {
+		return false;
+	}
+
+	if (!(m_impl->enable() & jh_detail::enable_result_enabled)) {
+
+		// Already enabled. A dependency may have been released in the meantime
+		if (!m_impl->remove_dependencies(1)) {
+			m_impl->get_target()->submit_job(m_impl);
+		}
+		return false;
+	}
+
+	m_impl->get_handler()->get_timer_queue().push(m_impl, deadline);
+
+	return true;
+}
+bool job::enable_after(std::chrono::microseconds delay) noexcept
+{
+	return enable_at(std::chrono::steady_clock::now() + delay);
+}
 bool job::enable_locally_if_ready() noexcept
 {
 	if (m_impl && m_impl->enable_if_ready()) {
@@ -105,6 +149,16 @@ bool job::is_finished() const noexcept
 {
 	return m_impl && m_impl->is_finished();
 }
+void job::cancel(bool cascade) noexcept
+{
+	if (m_impl) {
+		m_impl->cancel(jh_detail::job_cancel_skip | (cascade ? jh_detail::job_cancel_cascade : jh_detail::job_cancel_none));
+	}
+}
+bool job::is_cancelled() const noexcept
+{
+	return m_impl && m_impl->is_cancelled();
+}
 void job::wait_until_finished() noexcept
 {
 	if (!m_impl)
@@ -133,13 +187,13 @@ void job::work_until_ready(job_queue* consumeFrom)
 	if (m_impl)
 		m_impl->work_until_ready(consumeFrom);
 }
-job::job(gdul::shared_ptr<jh_detail::job_impl> impl) noexcept
+job::job(jh_detail::job_impl_ptr impl) noexcept
 	: m_impl(std::move(impl))
 {
 }
 job::operator bool() const noexcept
 {
-	return m_impl;
+	return (bool)m_impl;
 }
 float job::priority() const noexcept
 {
@@ -156,4 +210,58 @@ std::size_t job::get_id() const noexcept
 
 	return 0ull;
 }
+job when_all(const job* jobs, std::size_t count, const std::string_view& dbgName)
+{
+	assert(count && jobs[0] && "Expected at least one job");
+
+	job joined(jobs[0].m_impl->make_continuation(delegate<void()>([]() {}), jobs[0].m_impl->get_target(), dbgName));
+
+	if (joined.m_impl->try_add_dependencies((std::uint32_t)count)) {
+		std::uint32_t attached(0);
+
+		for (std::size_t i = 0; i < count; ++i) {
+			if (jobs[i] && jobs[i].m_impl->try_attach_child(joined.m_impl)) {
+				++attached;
+			}
+		}
+
+		// Not yet enabled, so this may never bring the count to zero
+		if (const std::uint32_t unattached = (std::uint32_t)count - attached) {
+			joined.m_impl->remove_dependencies(unattached);
+		}
+	}
+
+	joined.enable();
+
+	return joined;
+}
+job when_all(std::initializer_list<job> jobs, const std::string_view& dbgName)
+{
+	return when_all(jobs.begin(), jobs.size(), dbgName);
+}
+job when_any(const job* jobs, std::size_t count, const std::string_view& dbgName)
+{
+	assert(count && jobs[0] && "Expected at least one job");
+
+	job joined(jobs[0].m_impl->make_continuation(delegate<void()>([]() {}), jobs[0].m_impl->get_target(), dbgName));
+	joined.m_impl->set_release_on_any();
+
+	if (joined.m_impl->try_add_dependencies(1)) {
+		for (std::size_t i = 0; i < count; ++i) {
+			if (jobs[i] && !jobs[i].m_impl->try_attach_child(joined.m_impl)) {
+				// Already finished. No point in attaching to the rest
+				joined.m_impl->release_dependency();
+				break;
+			}
+		}
+	}
+
+	joined.enable();
+
+	return joined;
+}
+job when_any(std::initializer_list<job> jobs, const std::string_view& dbgName)
+{
+	return when_any(jobs.begin(), jobs.size(), dbgName);
 }
+}
\ No newline at end of file
@@ -21,7 +21,13 @@
 #pragma once
 
 #include <gdul/memory/atomic_shared_ptr.h>
+#include <gdul/execution/job_handler/job/job_impl_ptr.h>
 #include <gdul/execution/job_handler/job_handler_utility.h>
+#include <gdul/utility/delegate.h>
+
+#include <chrono>
+#include <initializer_list>
+#include <string_view>
 
 namespace gdul {
 
@@ -34,9 +40,12 @@ namespace jh_detail {
 class job_handler_impl;
 class job_impl;
 class worker_impl;
+class batch_job_graph_base;
 
 template <class InContainer, class OutContainer, class Process>
 class batch_job_impl;
+template <class InContainer, class Result>
+class batch_reduce_job_impl;
 }
 class job
 {
@@ -53,13 +62,31 @@ public:
 	void depends_on(job& dependency);
 	void depends_on(batch_job& dependency);
 
+	// Creates and enables a job that runs after this one has finished. May be called at any point, including 
+	// after this job has been enabled or has already finished. Continuation is placed in this job's queue
+	job then(delegate<void()> workUnit, const std::string_view& dbgName = "");
+
+	// Creates and enables a job that runs after this one has finished. May be called at any point, including 
+	// after this job has been enabled or has already finished
+	job then(delegate<void()> workUnit, job_queue* target, const std::string_view& dbgName = "");
+
 	// this object may be discarded once enable has been invoked
 	bool enable() noexcept;
 	bool enable_locally_if_ready() noexcept;
 
+	// Enables the job, holding it back from being enqueued until the deadline has passed as well as
+	// all of its dependencies. Deadlines have a resolution of jh_detail::TimerWheelTickUs
+	bool enable_at(std::chrono::steady_clock::time_point deadline) noexcept;
+	bool enable_after(std::chrono::microseconds delay) noexcept;
+
 	bool is_ready() const noexcept;
 	bool is_finished() const noexcept;
 
+	// Work unit will be skipped if it has not yet begun. Dependants are released as usual, or, if cascade is set, 
+	// are cancelled in turn. Running work units may poll is_cancelled (through job::this_job) to abort early
+	void cancel(bool cascade = false) noexcept;
+	bool is_cancelled() const noexcept;
+
 	void wait_until_finished() noexcept;
 	void wait_until_ready() noexcept;
 
@@ -80,11 +107,27 @@ private:
 	friend class jh_detail::worker_impl;
 	template <class InContainer, class OutContainer, class Process>
 	friend class jh_detail::batch_job_impl;
+	template <class InContainer, class Result>
+	friend class jh_detail::batch_reduce_job_impl;
+	friend class jh_detail::batch_job_graph_base;
 	friend class jh_detail::job_impl;
 	friend class jh_detail::job_handler_impl;
+	friend class job_graph_template;
+	friend job when_all(const job*, std::size_t, const std::string_view&);
+	friend job when_any(const job*, std::size_t, const std::string_view&);
 
-	job(gdul::shared_ptr<jh_detail::job_impl> impl) noexcept;
+	job(jh_detail::job_impl_ptr impl) noexcept;
 
-	gdul::shared_ptr<jh_detail::job_impl> m_impl;
+	jh_detail::job_impl_ptr m_impl;
 };
+
+// Creates an enabled job that finishes once all of jobs have finished. Dependency count is
+// updated once for the whole set. The joining job is placed in the first job's queue
+job when_all(const job* jobs, std::size_t count, const std::string_view& dbgName = "");
+job when_all(std::initializer_list<job> jobs, const std::string_view& dbgName = "");
+
+// Creates an enabled job that finishes once any of jobs has finished. The joining job is 
+// placed in the first job's queue
+job when_any(const job* jobs, std::size_t count, const std::string_view& dbgName = "");
+job when_any(std::initializer_list<job> jobs, const std::string_view& dbgName = "");
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gdul/execution/job_handler/job/job_graph_template.h>
+#include <gdul/execution/job_handler/job/job_impl.h>
+#include <gdul/execution/job_handler/job_handler.h>
+#include <gdul/execution/job_handler/job_handler_impl.h>
+
+#include <cassert>
+
+namespace gdul {
+namespace jh_detail {
+constexpr std::size_t Job_Graph_Template_Id = constexp_str_hash(std::string_view("gdul::job_graph_template"));
+}
+job_graph_template::job_graph_template(job_handler& handler, const std::string_view& name)
+	: job_graph_template(handler, name, jh_detail::allocator_type())
+{
+}
+job_graph_template::job_graph_template(job_handler& handler, const std::string_view& name, jh_detail::allocator_type allocator)
+	: m_jobs(allocator)
+	, m_successors(allocator)
+	, m_initialDependencies(allocator)
+	, m_roots(allocator)
+	, m_edges(allocator)
+	, m_handler(&handler)
+	, m_physicalId(jh_detail::Job_Graph_Template_Id + jh_detail::constexp_str_hash(name))
+	, m_sinkTarget(nullptr)
+	, m_unfinished(0)
+	, m_finalized(false)
+{
+}
+job_graph_template::~job_graph_template()
+{
+	wait_until_finished();
+
+	// Sink job may outlive us, in case it is still referenced
+	for (job_impl_ptr& jb : m_jobs) {
+		jb->set_persistent_dependees(jh_detail::job_persistent_dependees());
+	}
+}
+job_graph_template::node_id job_graph_template::add_job(delegate<void()> workUnit, job_queue* target, const std::string_view& dbgName)
+{
+	assert(!m_finalized && "Cannot add jobs to a finalized graph");
+
+	const node_id id((node_id)m_jobs.size());
+	job jb(m_handler->_redirect_make_job(m_physicalId, "", 0, std::move(workUnit), target, id, dbgName));
+	jb.m_impl->reset(0);
+
+	m_jobs.push_back(std::move(jb.m_impl));
+
+	if (!m_sinkTarget) {
+		m_sinkTarget = target;
+	}
+
+	return id;
+}
+void job_graph_template::add_dependency(node_id dependant, node_id dependency)
+{
+	assert(!m_finalized && "Cannot add dependencies to a finalized graph");
+	assert(dependant < m_jobs.size() && dependency < m_jobs.size() && "Unknown node");
+	assert(dependant != dependency && "Job may not depend on itself");
+
+	m_edges.emplace_back(dependency, dependant);
+}
+void job_graph_template::finalize()
+{
+	if (m_finalized) {
+		return;
+	}
+
+	assert(!m_jobs.empty() && "Graph is empty");
+
+	const node_id nodes((node_id)m_jobs.size());
+	const node_id sink(nodes);
+
+	job sinkJob(m_handler->_redirect_make_job(m_physicalId, "", 0, delegate<void()>([]() {}), m_sinkTarget, sink, "Graph Sink"));
+	sinkJob.m_impl->reset(0);
+	m_jobs.push_back(std::move(sinkJob.m_impl));
+
+	vector_type<std::uint32_t> offsets(m_jobs.size() + 1, 0, m_initialDependencies.get_allocator());
+	m_initialDependencies.assign(m_jobs.size(), 0);
+
+	for (const std::pair<node_id, node_id>& edge : m_edges) {
+		++offsets[edge.first + 1];
+		++m_initialDependencies[edge.second];
+	}
+
+	// Sink waits for every job without successors
+	for (node_id i = 0; i < nodes; ++i) {
+		if (!offsets[i + 1]) {
+			m_edges.emplace_back(i, sink);
+			++offsets[i + 1];
+			++m_initialDependencies[sink];
+		}
+	}
+
+	for (std::size_t i = 1; i < offsets.size(); ++i) {
+		offsets[i] += offsets[i - 1];
+	}
+
+	vector_type<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1, m_initialDependencies.get_allocator());
+
+	m_successors.resize(m_edges.size());
+	for (const std::pair<node_id, node_id>& edge : m_edges) {
+		m_successors[cursor[edge.first]++] = m_jobs[edge.second];
+	}
+
+	for (std::size_t i = 0; i < m_jobs.size(); ++i) {
+		jh_detail::job_persistent_dependees dependees;
+		dependees.m_begin = m_successors.data() + offsets[i];
+		dependees.m_count = offsets[i + 1] - offsets[i];
+		dependees.m_unfinished = &m_unfinished;
+
+		m_jobs[i]->set_persistent_dependees(dependees);
+
+		if (!m_initialDependencies[i]) {
+			m_roots.push_back((node_id)i);
+		}
+	}
+
+	m_edges.clear();
+	m_edges.shrink_to_fit();
+
+	m_finalized = true;
+}
+job job_graph_template::launch()
+{
+	finalize();
+
+	assert(is_finished() && "Graph launched before previous launch finished");
+
+	m_unfinished.store((std::uint32_t)m_jobs.size(), std::memory_order_relaxed);
+
+	// Roots are given a single dependency, released below once every job has been reset
+	for (std::size_t i = 0; i < m_jobs.size(); ++i) {
+		m_jobs[i]->reset(m_initialDependencies[i] ? m_initialDependencies[i] : 1);
+	}
+
+	for (node_id root : m_roots) {
+		jh_detail::job_impl::release_dependant(m_jobs[root]);
+	}
+
+	return job(m_jobs.back());
+}
+bool job_graph_template::is_finished() const noexcept
+{
+	return !m_unfinished.load(std::memory_order_acquire);
+}
+void job_graph_template::wait_until_finished() noexcept
+{
+	while (!is_finished()) {
+		jh_detail::job_handler_impl::t_items.this_worker_impl->refresh_sleep_timer();
+		jh_detail::job_handler_impl::t_items.this_worker_impl->idle();
+	}
+}
+std::size_t job_graph_template::size() const noexcept
+{
+	return m_finalized ? m_jobs.size() - 1 : m_jobs.size();
+}
+}
@@ -0,0 +1,129 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job_handler_utility.h>
+#include <gdul/execution/job_handler/job/job.h>
+#include <gdul/memory/atomic_shared_ptr.h>
+#include <gdul/utility/delegate.h>
+
+#include <atomic>
+#include <vector>
+#include <string_view>
+
+namespace gdul {
+class job_handler;
+class job_queue;
+
+namespace jh_detail {
+class job_impl;
+}
+
+/// <summary>
+/// A job dependency graph recorded once and launched any number of times. Successors and initial dependency counts 
+/// are kept in flat arrays and jobs are reused between launches, so that launching only resets counters and enqueues 
+/// root jobs. No allocations are made past the first launch (or finalize)
+/// </summary>
+class job_graph_template
+{
+public:
+	using node_id = std::uint32_t;
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	/// <param name="handler">Handler used to create the graph's jobs</param>
+	/// <param name="name">Graph name. Identifies the graph's jobs in job_info, and should be unique and stable between runs</param>
+	job_graph_template(job_handler& handler, const std::string_view& name);
+
+	/// <summary>
+	/// Constructor with allocator instance
+	/// </summary>
+	/// <param name="handler">Handler used to create the graph's jobs</param>
+	/// <param name="name">Graph name. Identifies the graph's jobs in job_info, and should be unique and stable between runs</param>
+	/// <param name="allocator">Allocator used for graph storage</param>
+	job_graph_template(job_handler& handler, const std::string_view& name, jh_detail::allocator_type allocator);
+
+	~job_graph_template();
+
+	job_graph_template(const job_graph_template&) = delete;
+	job_graph_template& operator=(const job_graph_template&) = delete;
+
+	/// <summary>
+	/// Record a job. May not be called once finalized
+	/// </summary>
+	/// <param name="workUnit">Work to be executed each launch</param>
+	/// <param name="target">Scheduling target</param>
+	/// <param name="dbgName">Job name</param>
+	/// <returns>Identifier used to declare dependencies</returns>
+	node_id add_job(delegate<void()> workUnit, job_queue* target, const std::string_view& dbgName = "");
+
+	/// <summary>
+	/// Record a dependency. May not be called once finalized
+	/// </summary>
+	/// <param name="dependant">Job that is to wait</param>
+	/// <param name="dependency">Job to wait for</param>
+	void add_dependency(node_id dependant, node_id dependency);
+
+	/// <summary>
+	/// Build the flat successor arrays. Called by the first launch if not called beforehand
+	/// </summary>
+	void finalize();
+
+	/// <summary>
+	/// Run the graph. The previous launch must have finished
+	/// </summary>
+	/// <returns>Job that finishes once every job in the graph has run. May be used as a dependency up until the next launch</returns>
+	job launch();
+
+	/// <summary>
+	/// True if no launch is in progress
+	/// </summary>
+	bool is_finished() const noexcept;
+
+	void wait_until_finished() noexcept;
+
+	std::size_t size() const noexcept;
+
+private:
+	template <class T>
+	using vector_type = std::vector<T, typename std::allocator_traits<jh_detail::allocator_type>::template rebind_alloc<T>>;
+
+	using job_impl_ptr = jh_detail::job_impl_ptr;
+
+	vector_type<job_impl_ptr> m_jobs;
+	vector_type<job_impl_ptr> m_successors;
+	vector_type<std::uint32_t> m_initialDependencies;
+	vector_type<node_id> m_roots;
+
+	vector_type<std::pair<node_id, node_id>> m_edges;
+
+	job_handler* const m_handler;
+
+	const std::size_t m_physicalId;
+
+	job_queue* m_sinkTarget;
+
+	std::atomic<std::uint32_t> m_unfinished;
+
+	bool m_finalized;
+};
+}
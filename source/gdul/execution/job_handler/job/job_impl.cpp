@@ -40,15 +40,34 @@ job_impl::job_impl(delegate<void()>&& workUnit, job_handler_impl* handler, job_q
 	, m_enqueueTimer()
 #endif
 	, m_finished(false)
+	, m_anyReleased(false)
+	, m_releaseOnAny(false)
 	, m_headDependee(nullptr)
+	, m_inlineDependee(nullptr)
+	, m_persistentDependees()
 	, m_handler(handler)
 	, m_target(target)
 	, m_dependencies(Job_Enable_Dependencies)
+	, m_refs(1)
+	, m_inlineDependeeState(inline_dependee_empty)
+	, m_cancel(job_cancel_none)
 {
 }
 job_impl::~job_impl()
 {
 	assert(is_enabled() && "Job destructor ran before enable was called");
+
+	// Left over if the job never ran. Dependants are dropped without being released
+	for (job_node* node = m_headDependee.load(std::memory_order_acquire); node;) {
+		job_node* const next(node->m_next);
+
+		pool_allocator<job_node> alloc(m_handler->get_job_node_allocator());
+
+		node->~job_node();
+		alloc.deallocate(node);
+
+		node = next;
+	}
 }
 
 void job_impl::operator()()
@@ -61,43 +80,69 @@ void job_impl::operator()()
 	}
 #endif
 
-	m_completionTimer.start();
+	if (!(m_cancel.load(std::memory_order_acquire) & job_cancel_skip)) {
+		job_tracer& tracer(m_handler->get_tracer());
+		const bool traced(tracer.is_enabled());
+
+		if (traced) {
+			tracer.record(job_trace_begin, this);
+		}
 
-	m_workUnit();
+		m_completionTimer.start();
 
-	m_info->store_runtime(m_completionTimer.elapsed());
+		m_workUnit();
+
+		if (traced) {
+			tracer.record(job_trace_end, this);
+		}
+
+		m_info->store_runtime(m_completionTimer.elapsed());
 
 #if defined(GDUL_JOB_DEBUG)
-	if (m_info)
-		m_info->m_completionTimeSet.log_time(m_completionTimer.elapsed());
+		if (m_info)
+			m_info->m_completionTimeSet.log_time(m_completionTimer.elapsed());
 #endif
+	}
 
 	m_finished.store(true, std::memory_order_seq_cst);
 
 	detach_children();
 }
-bool job_impl::try_attach_child(job_impl_shared_ptr child)
+bool job_impl::try_attach_child(job_impl_ptr child)
 {
 	m_info->accumulate_dependant_time(child->get_remaining_propagation_time());
 
-	pool_allocator<std::uint8_t> alloc(m_handler->get_job_node_allocator());
+	std::uint8_t expected(inline_dependee_empty);
+	if (m_inlineDependeeState.compare_exchange_strong(expected, inline_dependee_writing, std::memory_order_acquire, std::memory_order_relaxed)) {
+		m_inlineDependee = std::move(child);
 
-	job_node_shared_ptr dependee(gdul::allocate_shared<job_node>(alloc));
-	dependee->m_job = std::move(child);
+		expected = inline_dependee_writing;
+		if (m_inlineDependeeState.compare_exchange_strong(expected, inline_dependee_filled, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+			return true;
+		}
 
-	job_node_shared_ptr firstDependee(nullptr);
-	job_node_raw_ptr rawRep(nullptr);
-	do {
-		firstDependee = m_headDependee.load(std::memory_order_relaxed);
-		rawRep = firstDependee;
+		// Closed by detach_children in the meantime
+		m_inlineDependee.reset();
 
-		dependee->m_next = std::move(firstDependee);
+		return false;
+	}
+
+	pool_allocator<job_node> alloc(m_handler->get_job_node_allocator());
+
+	job_node* const dependee(new (alloc.allocate()) job_node{ nullptr, std::move(child) });
+
+	job_node* firstDependee(m_headDependee.load(std::memory_order_relaxed));
+	do {
+		dependee->m_next = firstDependee;
 
 		if (m_finished.load(std::memory_order_seq_cst)) {
+			dependee->~job_node();
+			alloc.deallocate(dependee);
+
 			return false;
 		}
 
-	} while (!m_headDependee.compare_exchange_strong(rawRep, std::move(dependee), std::memory_order_release, std::memory_order_relaxed));
+	} while (!m_headDependee.compare_exchange_weak(firstDependee, dependee, std::memory_order_release, std::memory_order_relaxed));
 
 	return true;
 }
@@ -119,6 +164,52 @@ std::uint32_t job_impl::remove_dependencies(std::uint32_t n)
 	std::uint32_t result(m_dependencies.fetch_sub(n, std::memory_order_acq_rel));
 	return result - n;
 }
+bool job_impl::release_dependency() noexcept
+{
+	if (m_releaseOnAny && m_anyReleased.exchange(true, std::memory_order_relaxed)) {
+		return false;
+	}
+
+	return !remove_dependencies(1);
+}
+void job_impl::reset(std::uint32_t dependencies) noexcept
+{
+	assert(!m_headDependee.load(std::memory_order_relaxed) && "Cannot reset job with attached dependants");
+
+	m_inlineDependeeState.store(inline_dependee_empty, std::memory_order_relaxed);
+	m_anyReleased.store(false, std::memory_order_relaxed);
+	m_cancel.store(job_cancel_none, std::memory_order_relaxed);
+	m_finished.store(false, std::memory_order_relaxed);
+	m_dependencies.store(dependencies, std::memory_order_release);
+}
+void job_impl::cancel(std::uint8_t flags) noexcept
+{
+	m_cancel.fetch_or(flags, std::memory_order_release);
+}
+bool job_impl::is_cancelled() const noexcept
+{
+	return m_cancel.load(std::memory_order_relaxed) & job_cancel_skip;
+}
+void job_impl::set_persistent_dependees(const job_persistent_dependees& dependees) noexcept
+{
+	m_persistentDependees = dependees;
+}
+void job_impl::set_release_on_any() noexcept
+{
+	assert(!is_enabled() && "Cannot change release mode after enable has been called");
+
+	m_releaseOnAny = true;
+}
+job job_impl::make_continuation(delegate<void()>&& workUnit, job_queue* target, [[maybe_unused]] const std::string_view& name)
+{
+	const std::size_t physicalId(get_id() ^ Job_Continuation_Id);
+
+#if defined (GDUL_JOB_DEBUG)
+	return m_handler->make_job_internal(std::move(workUnit), target, physicalId, 0, name, "", 0);
+#else
+	return m_handler->make_job_internal(std::move(workUnit), target, physicalId, 0);
+#endif
+}
 enable_result job_impl::enable() noexcept
 {
 	std::uint32_t exp(m_dependencies.load(std::memory_order_relaxed));
@@ -147,6 +238,10 @@ job_queue* job_impl::get_target() const noexcept
 {
 	return m_target;
 }
+job_handler_impl* job_impl::get_handler() const noexcept
+{
+	return m_handler;
+}
 bool job_impl::is_finished() const noexcept
 {
 	return m_finished.load(std::memory_order_relaxed);
@@ -232,21 +327,94 @@ void job_impl::set_info(job_info* info)
 {
 	m_info = info;
 }
-void job_impl::detach_children()
+void job_impl::destroy() noexcept
 {
-	detach_next(m_headDependee.exchange(job_node_shared_ptr(nullptr), std::memory_order_relaxed));
+	assert(m_handler && "Job was not created by a handler");
+
+	pool_allocator<job_impl> alloc(m_handler->get_job_impl_allocator());
+
+	this->~job_impl();
+
+	alloc.deallocate(this);
 }
-void job_impl::detach_next(job_node_shared_ptr from)
+void job_impl::detach_children()
 {
-	if (!from) {
-		return;
+	const bool cascadeCancel(m_cancel.load(std::memory_order_acquire) & job_cancel_cascade);
+
+	// Dependency edges are traced as they are released, covering inline, node and persistent dependants alike
+	job_tracer* const tracer(m_handler->get_tracer().is_enabled() ? &m_handler->get_tracer() : nullptr);
+
+	job_release_batch released;
+
+	if (m_inlineDependeeState.exchange(inline_dependee_closed, std::memory_order_acq_rel) == inline_dependee_filled) {
+		if (tracer) {
+			tracer->record(job_trace_release, this, m_inlineDependee.get());
+		}
+
+		if (prepare_release(m_inlineDependee.get(), cascadeCancel)) {
+			released.add(std::move(m_inlineDependee));
+		}
+		else {
+			m_inlineDependee.reset();
+		}
+	}
+
+	// Nodes are pushed to the front, so the list is reversed to release dependants in the order they were attached
+	job_node* node(nullptr);
+	for (job_node* at = m_headDependee.exchange(nullptr, std::memory_order_acquire); at;) {
+		job_node* const next(at->m_next);
+		at->m_next = node;
+		node = at;
+		at = next;
+	}
+
+	while (node) {
+		job_node* const next(node->m_next);
+		job_impl_ptr dependant(std::move(node->m_job));
+
+		pool_allocator<job_node> alloc(m_handler->get_job_node_allocator());
+
+		node->~job_node();
+		alloc.deallocate(node);
+
+		if (tracer) {
+			tracer->record(job_trace_release, this, dependant.get());
+		}
+
+		if (prepare_release(dependant.get(), cascadeCancel)) {
+			released.add(std::move(dependant));
+		}
+
+		node = next;
+	}
+
+	for (std::uint32_t i = 0; i < m_persistentDependees.m_count; ++i) {
+		if (tracer) {
+			tracer->record(job_trace_release, this, m_persistentDependees.m_begin[i].get());
+		}
+
+		if (prepare_release(m_persistentDependees.m_begin[i].get(), cascadeCancel)) {
+			released.add(m_persistentDependees.m_begin[i]);
+		}
 	}
 
-	job_impl_shared_ptr dependant(std::move(from->m_job));
+	released.flush();
 
-	detach_next(std::move(from->m_next));
+	if (m_persistentDependees.m_unfinished) {
+		m_persistentDependees.m_unfinished->fetch_sub(1, std::memory_order_release);
+	}
+}
+bool job_impl::prepare_release(job_impl* dependant, bool cascadeCancel) noexcept
+{
+	if (cascadeCancel) {
+		dependant->cancel(job_cancel_skip | job_cancel_cascade);
+	}
 
-	if (!dependant->remove_dependencies(1)) {
+	return dependant->release_dependency();
+}
+void job_impl::release_dependant(job_impl_ptr dependant, bool cascadeCancel)
+{
+	if (prepare_release(dependant.get(), cascadeCancel)) {
 		job_queue* const target(dependant->get_target());
 
 		target->submit_job(std::move(dependant));
@@ -258,5 +426,47 @@ void job_impl::on_enqueue() noexcept
 	m_enqueueTimer.reset();
 }
 #endif
+job_release_batch::job_release_batch() noexcept
+	: m_jobs()
+	, m_target(nullptr)
+	, m_count(0)
+{
+}
+job_release_batch::~job_release_batch()
+{
+	flush();
+}
+void job_release_batch::add(job_impl_ptr dependant)
+{
+	job_queue* const target(dependant->get_target());
+
+	if (m_count && (target != m_target || m_count == m_jobs.size())) {
+		flush();
+	}
+
+	m_target = target;
+	m_jobs[m_count++] = std::move(dependant);
+}
+void job_release_batch::flush()
+{
+	if (!m_count) {
+		return;
+	}
+
+	// Moved from, leaving the entries empty
+	m_target->submit_jobs(m_jobs.data(), m_count);
+
+	m_count = 0;
+}
+void job_impl_add_ref(job_impl* jb) noexcept
+{
+	jb->m_refs.fetch_add(1, std::memory_order_relaxed);
+}
+void job_impl_release(job_impl* jb) noexcept
+{
+	if (jb->m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		jb->destroy();
+	}
+}
 }
 }
@@ -26,10 +26,14 @@
 #include <gdul/execution/job_handler/tracking/job_graph.h>
 #include <gdul/execution/job_handler/tracking/timer.h>
 #include <gdul/execution/job_handler/job/job_node.h>
+#include <gdul/execution/job_handler/job/job.h>
 
-#include <gdul/memory/atomic_shared_ptr.h>
 #include <gdul/utility/delegate.h>
 
+#include <array>
+#include <atomic>
+#include <string_view>
+
 namespace gdul {
 class job_queue;
 
@@ -45,17 +49,57 @@ enum enable_result : std::uint8_t
 	enable_result_enqueue = 1 << 1,
 };
 
+enum inline_dependee_state : std::uint8_t
+{
+	inline_dependee_empty,
+	inline_dependee_writing,
+	inline_dependee_filled,
+	inline_dependee_closed,
+};
+
+enum job_cancel_flag : std::uint8_t
+{
+	job_cancel_none = 0,
+	// Work unit is skipped. Dependants are released as usual
+	job_cancel_skip = 1 << 0,
+	// Dependants are cancelled as they are released
+	job_cancel_cascade = 1 << 1,
+};
+
 class job_handler_impl;
+class job_impl;
+
+// Successors owned by a job_graph_template, released as the job finishes in place of per-edge job_nodes
+struct job_persistent_dependees
+{
+	job_impl_ptr* m_begin = nullptr;
+	std::uint32_t m_count = 0;
+
+	// Decremented as the very last step of running the job, after which the job may be reset
+	std::atomic<std::uint32_t>* m_unfinished = nullptr;
+};
+
+// Dependants released by a finishing job. Runs of dependants sharing a target queue are submitted in bulk
+class job_release_batch
+{
+public:
+	job_release_batch() noexcept;
+	~job_release_batch();
+
+	void add(job_impl_ptr dependant);
+	void flush();
+
+private:
+	std::array<job_impl_ptr, JobReleaseBatchSize> m_jobs;
+	job_queue* m_target;
+	std::uint32_t m_count;
+};
 
 class job_impl
 {
 public:
 	using allocator_type = gdul::jh_detail::allocator_type;
 
-	using job_impl_shared_ptr = shared_ptr<job_impl>;
-	using job_impl_atomic_shared_ptr = atomic_shared_ptr<job_impl>;
-	using job_impl_raw_ptr = raw_ptr<job_impl>;
-
 	job_impl();
 	job_impl(delegate<void()>&& workUnit, job_handler_impl* handler, job_queue* target, job_info* info);
 
@@ -63,15 +107,35 @@ public:
 
 	void operator()();
 
-	bool try_attach_child(job_impl_shared_ptr child);
+	bool try_attach_child(job_impl_ptr child);
 
 	bool try_add_dependencies(std::uint32_t n = 1);
 	std::uint32_t remove_dependencies(std::uint32_t n = 1);
 
+	// Called as a dependency finishes. Returns true if this job should be enqueued
+	bool release_dependency() noexcept;
+
+	// Job will be released by whichever dependency finishes first. Must be set before dependencies are attached
+	void set_release_on_any() noexcept;
+
+	job make_continuation(delegate<void()>&& workUnit, job_queue* target, const std::string_view& name);
+
+	// Prepare a finished (or never run) job to be run again. Job is considered enabled
+	void reset(std::uint32_t dependencies) noexcept;
+
+	void set_persistent_dependees(const job_persistent_dependees& dependees) noexcept;
+
+	void cancel(std::uint8_t flags) noexcept;
+	bool is_cancelled() const noexcept;
+
+	// Releases one dependency of dependant, enqueueing it if it was the last
+	static void release_dependant(job_impl_ptr dependant, bool cascadeCancel = false);
+
 	enable_result enable() noexcept;
 	bool enable_if_ready() noexcept;
 
 	job_queue* get_target() const noexcept;
+	job_handler_impl* get_handler() const noexcept;
 
 	bool is_finished() const noexcept;
 	bool is_enabled() const noexcept;
@@ -94,8 +158,15 @@ public:
 #endif
 
 private:
+	friend void job_impl_add_ref(job_impl* jb) noexcept;
+	friend void job_impl_release(job_impl* jb) noexcept;
+
+	void destroy() noexcept;
+
 	void detach_children();
-	static void detach_next(job_node_shared_ptr from);
+
+	// Cancels dependant if cascading, and releases one of its dependencies. Returns true if it should be enqueued
+	static bool prepare_release(job_impl* dependant, bool cascadeCancel) noexcept;
 
 	delegate<void()> m_workUnit;
 
@@ -110,11 +181,24 @@ private:
 	job_handler_impl* const m_handler;
 	job_queue* const m_target;
 
-	atomic_shared_ptr<job_node> m_headDependee;
+	std::atomic<job_node*> m_headDependee;
+
+	// The first dependant is kept inline, sparing a job_node allocation for the common single continuation case
+	job_impl_ptr m_inlineDependee;
+
+	job_persistent_dependees m_persistentDependees;
 
 	std::atomic<std::uint32_t> m_dependencies;
 
+	// Held by job_impl_ptr. Starts at one, for the reference handed out on creation
+	std::atomic<std::uint32_t> m_refs;
+
+	std::atomic<std::uint8_t> m_inlineDependeeState;
+	std::atomic<std::uint8_t> m_cancel;
+
 	std::atomic_bool m_finished;
+	std::atomic_bool m_anyReleased;
+	bool m_releaseOnAny;
 };
 }
 }
@@ -0,0 +1,172 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace gdul {
+namespace jh_detail {
+
+class job_impl;
+
+// Reference counting is done on a counter kept within job_impl. Out of line, since job_impl is not
+// complete at most points of use. The last release destroys the job and returns its block to the job pool
+void job_impl_add_ref(job_impl* jb) noexcept;
+void job_impl_release(job_impl* jb) noexcept;
+
+// Intrusive reference to a job_impl. Moving, adopting and detaching never touch the counter, so that 
+// handing a job from queue to queue or from dependency to dependant does no reference count traffic
+class job_impl_ptr
+{
+public:
+	job_impl_ptr() noexcept;
+	job_impl_ptr(std::nullptr_t) noexcept;
+
+	job_impl_ptr(job_impl_ptr&& other) noexcept;
+	job_impl_ptr(const job_impl_ptr& other) noexcept;
+
+	~job_impl_ptr();
+
+	job_impl_ptr& operator=(job_impl_ptr&& other) noexcept;
+	job_impl_ptr& operator=(const job_impl_ptr& other) noexcept;
+
+	// Takes over a reference already held by jb, such as one given up by detach
+	static job_impl_ptr adopt(job_impl* jb) noexcept;
+
+	// Gives up ownership of the held reference without releasing it. It is to be taken back using adopt
+	job_impl* detach() noexcept;
+
+	void reset() noexcept;
+
+	job_impl* get() const noexcept;
+
+	job_impl* operator->() const noexcept;
+	job_impl& operator*() const noexcept;
+
+	explicit operator bool() const noexcept;
+
+	bool operator==(const job_impl_ptr& other) const noexcept;
+	bool operator!=(const job_impl_ptr& other) const noexcept;
+
+private:
+	job_impl* m_ptr;
+};
+
+inline job_impl_ptr::job_impl_ptr() noexcept
+	: m_ptr(nullptr)
+{
+}
+inline job_impl_ptr::job_impl_ptr(std::nullptr_t) noexcept
+	: m_ptr(nullptr)
+{
+}
+inline job_impl_ptr::job_impl_ptr(job_impl_ptr&& other) noexcept
+	: m_ptr(other.m_ptr)
+{
+	other.m_ptr = nullptr;
+}
+inline job_impl_ptr::job_impl_ptr(const job_impl_ptr& other) noexcept
+	: m_ptr(other.m_ptr)
+{
+	if (m_ptr) {
+		job_impl_add_ref(m_ptr);
+	}
+}
+inline job_impl_ptr::~job_impl_ptr()
+{
+	if (m_ptr) {
+		job_impl_release(m_ptr);
+	}
+}
+inline job_impl_ptr& job_impl_ptr::operator=(job_impl_ptr&& other) noexcept
+{
+	if (this != &other) {
+		job_impl* const previous(m_ptr);
+
+		m_ptr = other.m_ptr;
+		other.m_ptr = nullptr;
+
+		if (previous) {
+			job_impl_release(previous);
+		}
+	}
+	return *this;
+}
+inline job_impl_ptr& job_impl_ptr::operator=(const job_impl_ptr& other) noexcept
+{
+	if (other.m_ptr) {
+		job_impl_add_ref(other.m_ptr);
+	}
+
+	job_impl* const previous(m_ptr);
+	m_ptr = other.m_ptr;
+
+	if (previous) {
+		job_impl_release(previous);
+	}
+
+	return *this;
+}
+inline job_impl_ptr job_impl_ptr::adopt(job_impl* jb) noexcept
+{
+	job_impl_ptr out;
+	out.m_ptr = jb;
+	return out;
+}
+inline job_impl* job_impl_ptr::detach() noexcept
+{
+	job_impl* const out(m_ptr);
+	m_ptr = nullptr;
+	return out;
+}
+inline void job_impl_ptr::reset() noexcept
+{
+	if (job_impl* const previous = detach()) {
+		job_impl_release(previous);
+	}
+}
+inline job_impl* job_impl_ptr::get() const noexcept
+{
+	return m_ptr;
+}
+inline job_impl* job_impl_ptr::operator->() const noexcept
+{
+	return m_ptr;
+}
+inline job_impl& job_impl_ptr::operator*() const noexcept
+{
+	return *m_ptr;
+}
+inline job_impl_ptr::operator bool() const noexcept
+{
+	return m_ptr;
+}
+inline bool job_impl_ptr::operator==(const job_impl_ptr& other) const noexcept
+{
+	return m_ptr == other.m_ptr;
+}
+inline bool job_impl_ptr::operator!=(const job_impl_ptr& other) const noexcept
+{
+	return m_ptr != other.m_ptr;
+}
+}
+}
@@ -20,23 +20,19 @@
 
 #pragma once
 
-#include <gdul/memory/atomic_shared_ptr.h>
+#include <gdul/execution/job_handler/job/job_impl_ptr.h>
 
 namespace gdul
 {
 namespace jh_detail
 {
 
-class job_impl;
-
+// Entry in a job's list of dependants. Nodes are only ever pushed, and the list is taken as a whole once 
+// the job finishes, so a plain pointer (Treiber) list suffices
 struct job_node
 {
-	gdul::shared_ptr<job_node> m_next;
-	gdul::shared_ptr<job_impl> m_job;
+	job_node* m_next;
+	job_impl_ptr m_job;
 };
-
-using job_node_shared_ptr = gdul::shared_ptr<job_node>;
-using job_node_atomic_shared_ptr = gdul::atomic_shared_ptr<job_node>;
-using job_node_raw_ptr = gdul::raw_ptr<job_node>;
 }
 }
\ No newline at end of file
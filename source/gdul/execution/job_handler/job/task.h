@@ -0,0 +1,435 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job/job.h>
+#include <gdul/execution/job_handler/job/batch_job.h>
+#include <gdul/execution/job_handler/job_handler.h>
+#include <gdul/utility/delegate.h>
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <atomic>
+#include <optional>
+#include <exception>
+#include <cassert>
+#include <utility>
+
+namespace gdul {
+
+template <class T = void>
+class task;
+
+namespace jh_detail {
+
+enum task_state : std::uint8_t
+{
+	task_state_none = 0,
+	task_state_completed = 1 << 0,
+	task_state_detached = 1 << 1,
+};
+
+constexpr std::size_t Task_Resume_Id = constexp_str_hash(std::string_view("gdul::task resume"));
+constexpr std::size_t Task_Completion_Id = constexp_str_hash(std::string_view("gdul::task completion"));
+
+// Creates a (not yet enabled) job that resumes the coroutine at handle once run
+inline job make_resume_job(std::coroutine_handle<> handle, job_handler& handler, job_queue* target)
+{
+	return handler._redirect_make_job(Task_Resume_Id, __FILE__, __LINE__, delegate<void()>([handle]() { handle.resume(); }), target, "Task Resume");
+}
+
+// Suspends the awaiting coroutine until a job has finished. The coroutine is then resumed 
+// by a job posted to the coroutine's target queue
+template <class Dependency>
+class job_awaiter
+{
+public:
+	job_awaiter(Dependency dependency, job_handler* handler, job_queue* target)
+		: m_dependency(std::move(dependency))
+		, m_handler(handler)
+		, m_target(target)
+	{}
+
+	bool await_ready() const noexcept
+	{
+		return m_dependency.is_finished();
+	}
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		job resume(make_resume_job(handle, *m_handler, m_target));
+		resume.depends_on(m_dependency);
+
+		// The coroutine may be resumed (and this awaiter destroyed) the moment the resume job is enabled
+		resume.enable();
+	}
+	void await_resume() const noexcept
+	{
+	}
+
+private:
+	Dependency m_dependency;
+	job_handler* const m_handler;
+	job_queue* const m_target;
+};
+
+// Awaits completion of another task, starting it on the awaiting coroutine's handler and queue 
+// if it has not been started already
+template <class T, class TaskRef>
+class task_awaiter
+{
+public:
+	task_awaiter(TaskRef&& awaited, job_handler* handler, job_queue* target)
+		: m_task(std::forward<TaskRef>(awaited))
+		, m_handler(handler)
+		, m_target(target)
+	{}
+
+	bool await_ready() const noexcept
+	{
+		return m_task.is_finished();
+	}
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		if (!m_task.is_started()) {
+			m_task.start(*m_handler, m_target);
+		}
+
+		job resume(make_resume_job(handle, *m_handler, m_target));
+		job completion(m_task.get_job());
+		resume.depends_on(completion);
+		resume.enable();
+	}
+	decltype(auto) await_resume()
+	{
+		if constexpr (std::is_void_v<T>) {
+			return;
+		}
+		else if constexpr (std::is_lvalue_reference_v<TaskRef>) {
+			return m_task.get_result();
+		}
+		else {
+			return T(std::move(m_task.get_result()));
+		}
+	}
+
+private:
+	TaskRef m_task;
+	job_handler* const m_handler;
+	job_queue* const m_target;
+};
+
+class task_promise_base
+{
+public:
+	// The frame is destroyed by whichever of final_awaiter and task::release comes last, each setting its flag 
+	// with a single read-modify-write and observing the other's. A coroutine is suspended as soon as await_suspend 
+	// is entered, so the frame may be destroyed from within it. Nothing in the frame is touched past the flag
+	struct final_awaiter
+	{
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+		template <class Promise>
+		bool await_suspend(std::coroutine_handle<Promise> handle) noexcept
+		{
+			task_promise_base& promise(handle.promise());
+
+			job completion(std::move(promise.m_completion));
+
+			const std::uint8_t state(promise.m_state.fetch_or(task_state_completed, std::memory_order_acq_rel));
+
+			// Past this point the frame may have been destroyed by the owning task
+			completion.enable();
+
+			// If detached, resume so that the frame is destroyed on leaving final suspend
+			return !(state & task_state_detached);
+		}
+		void await_resume() const noexcept
+		{
+		}
+	};
+
+	std::suspend_always initial_suspend() const noexcept
+	{
+		return {};
+	}
+	final_awaiter final_suspend() const noexcept
+	{
+		return {};
+	}
+	void unhandled_exception() noexcept
+	{
+		assert(false && "Unhandled exception in task");
+		std::terminate();
+	}
+
+	job_awaiter<job> await_transform(job dependency)
+	{
+		return job_awaiter<job>(std::move(dependency), m_handler, m_target);
+	}
+	job_awaiter<batch_job> await_transform(batch_job dependency)
+	{
+		return job_awaiter<batch_job>(std::move(dependency), m_handler, m_target);
+	}
+	template <class U>
+	task_awaiter<U, task<U>&> await_transform(task<U>& awaited)
+	{
+		return task_awaiter<U, task<U>&>(awaited, m_handler, m_target);
+	}
+	template <class U>
+	task_awaiter<U, task<U>> await_transform(task<U>&& awaited)
+	{
+		return task_awaiter<U, task<U>>(std::move(awaited), m_handler, m_target);
+	}
+	template <class Awaitable>
+	Awaitable&& await_transform(Awaitable&& awaitable) noexcept
+	{
+		return std::forward<Awaitable>(awaitable);
+	}
+
+private:
+	template <class>
+	friend class gdul::task;
+
+	job m_completion;
+
+	job_handler* m_handler = nullptr;
+	job_queue* m_target = nullptr;
+
+	std::atomic<std::uint8_t> m_state = task_state_none;
+};
+
+template <class T>
+class task_promise : public task_promise_base
+{
+public:
+	task<T> get_return_object() noexcept;
+
+	template <class U>
+	void return_value(U&& value)
+	{
+		m_result.emplace(std::forward<U>(value));
+	}
+
+	T& get_result() noexcept
+	{
+		assert(m_result && "Task has not finished");
+		return *m_result;
+	}
+
+private:
+	std::optional<T> m_result;
+};
+template <>
+class task_promise<void> : public task_promise_base
+{
+public:
+	task<void> get_return_object() noexcept;
+
+	void return_void() noexcept
+	{
+	}
+	void get_result() noexcept
+	{
+	}
+};
+}
+
+/// <summary>
+/// Coroutine executed by jobs. Within a task, co_await on a job, batch_job or another task suspends the coroutine 
+/// without blocking the worker. Once the awaited job finishes the coroutine is resumed by a job posted to the task's target queue.
+/// A task does nothing until started (or awaited from another task, in which case it inherits handler and queue)
+/// </summary>
+template <class T>
+class task
+{
+public:
+	using promise_type = jh_detail::task_promise<T>;
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	task() noexcept;
+	task(task&& other) noexcept;
+	task& operator=(task&& other) noexcept;
+
+	task(const task&) = delete;
+	task& operator=(const task&) = delete;
+
+	/// <summary>
+	/// Destructor. A running coroutine will be left to finish on its own
+	/// </summary>
+	~task();
+
+	/// <summary>
+	/// Schedule the coroutine to be run
+	/// </summary>
+	/// <param name="handler">Handler used to create resume jobs</param>
+	/// <param name="target">Queue the coroutine is run from</param>
+	/// <returns>Job that finishes once the coroutine has completed. May be used as dependency</returns>
+	job start(job_handler& handler, job_queue* target);
+
+	/// <summary>
+	/// Job that finishes once the coroutine has completed. Only valid once started
+	/// </summary>
+	job get_job() const noexcept;
+
+	bool is_started() const noexcept;
+	bool is_finished() const noexcept;
+
+	void wait_until_finished() noexcept;
+
+	// Consume jobs until finished. Beware of recursive calls (stack overflow, stalls etc..)
+	void work_until_finished(job_queue* consumeFrom);
+
+	/// <summary>
+	/// Returnvalue of the coroutine. Only valid once finished
+	/// </summary>
+	decltype(auto) get_result() noexcept;
+
+private:
+	friend class jh_detail::task_promise<T>;
+
+	task(handle_type handle) noexcept;
+
+	void release() noexcept;
+
+	handle_type m_handle;
+	job m_completion;
+};
+template<class T>
+inline task<T>::task() noexcept
+	: m_handle(nullptr)
+	, m_completion()
+{
+}
+template<class T>
+inline task<T>::task(handle_type handle) noexcept
+	: m_handle(handle)
+	, m_completion()
+{
+}
+template<class T>
+inline task<T>::task(task&& other) noexcept
+	: m_handle(std::exchange(other.m_handle, nullptr))
+	, m_completion(std::move(other.m_completion))
+{
+}
+template<class T>
+inline task<T>& task<T>::operator=(task&& other) noexcept
+{
+	if (this != &other) {
+		release();
+		m_handle = std::exchange(other.m_handle, nullptr);
+		m_completion = std::move(other.m_completion);
+	}
+	return *this;
+}
+template<class T>
+inline task<T>::~task()
+{
+	release();
+}
+template<class T>
+inline job task<T>::start(job_handler& handler, job_queue* target)
+{
+	assert(m_handle && "Task has no coroutine");
+	assert(!is_started() && "Task already started");
+
+	promise_type& promise(m_handle.promise());
+	promise.m_handler = &handler;
+	promise.m_target = target;
+	promise.m_completion = handler._redirect_make_job(jh_detail::Task_Completion_Id, __FILE__, __LINE__, delegate<void()>([]() {}), target, "Task Completion");
+
+	m_completion = promise.m_completion;
+
+	job begin(jh_detail::make_resume_job(m_handle, handler, target));
+	begin.enable();
+
+	return m_completion;
+}
+template<class T>
+inline job task<T>::get_job() const noexcept
+{
+	return m_completion;
+}
+template<class T>
+inline bool task<T>::is_started() const noexcept
+{
+	return m_completion;
+}
+template<class T>
+inline bool task<T>::is_finished() const noexcept
+{
+	return m_completion.is_finished();
+}
+template<class T>
+inline void task<T>::wait_until_finished() noexcept
+{
+	m_completion.wait_until_finished();
+}
+template<class T>
+inline void task<T>::work_until_finished(job_queue* consumeFrom)
+{
+	m_completion.work_until_finished(consumeFrom);
+}
+template<class T>
+inline decltype(auto) task<T>::get_result() noexcept
+{
+	assert(is_finished() && "Task has not finished");
+	return m_handle.promise().get_result();
+}
+template<class T>
+inline void task<T>::release() noexcept
+{
+	if (!m_handle) {
+		return;
+	}
+
+	const handle_type handle(std::exchange(m_handle, nullptr));
+
+	if (!m_completion) {
+		handle.destroy();
+		return;
+	}
+
+	const std::uint8_t state(handle.promise().m_state.fetch_or(jh_detail::task_state_detached, std::memory_order_acq_rel));
+
+	// Otherwise the coroutine destroys its frame on completion
+	if (state & jh_detail::task_state_completed) {
+		handle.destroy();
+	}
+
+	m_completion = job();
+}
+namespace jh_detail {
+template<class T>
+inline task<T> task_promise<T>::get_return_object() noexcept
+{
+	return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+inline task<void> task_promise<void>::get_return_object() noexcept
+{
+	return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+}
+}
+#endif
@@ -0,0 +1,219 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "job_block_pool.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gdul {
+namespace jh_detail {
+
+// Ids rather than addresses identify owners, so that a pool constructed where a destroyed one used to be 
+// is not handed blocks that were never its own
+static std::atomic<std::uint64_t> s_poolIds(1);
+
+// Live pools, consulted when a stack changes owner. Rare enough for a lock
+static std::mutex s_registryLock;
+static std::vector<job_block_pool*> s_registry;
+
+thread_local std::array<job_block_cache, job_block_slot_count> job_block_pool::t_caches{};
+
+job_block_cache::~job_block_cache()
+{
+	job_block_pool::release(*this);
+}
+
+job_block_pool::job_block_pool(pool_allocator<std::uint8_t> shared, size_type itemSize, size_type itemAlign, job_block_slot slot, allocator_type allocator)
+	: m_shared(shared)
+	, m_allocator(allocator)
+	, m_itemSize(itemSize)
+	, m_itemAlign(itemAlign)
+	, m_id(s_poolIds.fetch_add(1, std::memory_order_relaxed))
+	, m_fullMagazines()
+	, m_emptyMagazines()
+	, m_allMagazines(nullptr)
+	, m_hits(0)
+	, m_misses(0)
+	, m_slot(slot)
+{
+	std::lock_guard<std::mutex> lock(s_registryLock);
+	s_registry.push_back(this);
+}
+job_block_pool::~job_block_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(s_registryLock);
+		s_registry.erase(std::find(s_registry.begin(), s_registry.end(), this));
+	}
+
+	// Blocks still held go with the shared pool
+	job_block_magazine* magazine(m_allMagazines.load(std::memory_order_acquire));
+	while (magazine) {
+		job_block_magazine* const next(magazine->m_nextAllocated);
+		std::allocator_traits<magazine_allocator_type>::destroy(m_allocator, magazine);
+		m_allocator.deallocate(magazine, 1);
+		magazine = next;
+	}
+}
+void job_block_pool::release(job_block_cache& cache)
+{
+	if (cache.m_loaded || cache.m_previous) {
+		std::lock_guard<std::mutex> lock(s_registryLock);
+
+		for (job_block_pool* pool : s_registry) {
+			if (pool->m_id == cache.m_owner) {
+				for (job_block_magazine* magazine : { cache.m_loaded, cache.m_previous }) {
+					if (magazine) {
+						push_magazine(magazine->m_count ? pool->m_fullMagazines : pool->m_emptyMagazines, magazine);
+					}
+				}
+				pool->m_hits.fetch_add(cache.m_hits, std::memory_order_relaxed);
+				break;
+			}
+		}
+	}
+
+	cache.m_loaded = nullptr;
+	cache.m_previous = nullptr;
+	cache.m_hits = 0;
+}
+void* job_block_pool::get_block()
+{
+	job_block_cache& cache(this_cache());
+
+	if (!(cache.m_loaded && cache.m_loaded->m_count) && cache.m_previous && cache.m_previous->m_count) {
+		std::swap(cache.m_loaded, cache.m_previous);
+	}
+
+	if (!(cache.m_loaded && cache.m_loaded->m_count)) {
+		m_hits.fetch_add(cache.m_hits, std::memory_order_relaxed);
+		cache.m_hits = 0;
+
+		job_block_magazine* const full(pop_magazine(m_fullMagazines));
+
+		if (!full) {
+			m_misses.fetch_add(1, std::memory_order_relaxed);
+			return m_shared.allocate();
+		}
+
+		if (cache.m_previous) {
+			push_magazine(m_emptyMagazines, cache.m_previous);
+		}
+		cache.m_previous = cache.m_loaded;
+		cache.m_loaded = full;
+	}
+
+	++cache.m_hits;
+
+	return cache.m_loaded->m_blocks[--cache.m_loaded->m_count];
+}
+void job_block_pool::recycle_block(void* block)
+{
+	job_block_cache& cache(this_cache());
+
+	if (!(cache.m_loaded && cache.m_loaded->m_count < JobBlockMagazineSize) && cache.m_previous && cache.m_previous->m_count < JobBlockMagazineSize) {
+		std::swap(cache.m_loaded, cache.m_previous);
+	}
+
+	if (!(cache.m_loaded && cache.m_loaded->m_count < JobBlockMagazineSize)) {
+		m_hits.fetch_add(cache.m_hits, std::memory_order_relaxed);
+		cache.m_hits = 0;
+
+		if (cache.m_previous) {
+			push_magazine(m_fullMagazines, cache.m_previous);
+		}
+		cache.m_previous = cache.m_loaded;
+		cache.m_loaded = make_magazine();
+	}
+
+	cache.m_loaded->m_blocks[cache.m_loaded->m_count++] = block;
+}
+bool job_block_pool::verify_compatibility(size_type itemSize, size_type itemAlign) const
+{
+	return !(m_itemSize < itemSize) && !(m_itemAlign < itemAlign);
+}
+std::uint64_t job_block_pool::hits() const noexcept
+{
+	return m_hits.load(std::memory_order_relaxed);
+}
+std::uint64_t job_block_pool::misses() const noexcept
+{
+	return m_misses.load(std::memory_order_relaxed);
+}
+job_block_cache& job_block_pool::this_cache()
+{
+	job_block_cache& cache(t_caches[m_slot]);
+
+	if (cache.m_owner != m_id) {
+		release(cache);
+		cache.m_owner = m_id;
+	}
+
+	return cache;
+}
+job_block_magazine* job_block_pool::make_magazine()
+{
+	if (job_block_magazine* const empty = pop_magazine(m_emptyMagazines)) {
+		return empty;
+	}
+
+	job_block_magazine* const magazine(m_allocator.allocate(1));
+	std::allocator_traits<magazine_allocator_type>::construct(m_allocator, magazine);
+	magazine->m_next.store(nullptr, std::memory_order_relaxed);
+	magazine->m_count = 0;
+
+	magazine->m_nextAllocated = m_allMagazines.load(std::memory_order_relaxed);
+	while (!m_allMagazines.compare_exchange_weak(magazine->m_nextAllocated, magazine, std::memory_order_release, std::memory_order_relaxed));
+
+	return magazine;
+}
+void job_block_pool::push_magazine(atomic_128<u128>& list, job_block_magazine* magazine)
+{
+	// A torn first read only costs a retry
+	u128 expected(list.my_val());
+	u128 desired;
+
+	do {
+		magazine->m_next.store((job_block_magazine*)expected.m_u64[0], std::memory_order_relaxed);
+		desired = u128((std::uint64_t)magazine, expected.m_u64[1] + 1);
+	} while (!list.compare_exchange_strong(expected, desired));
+}
+job_block_magazine* job_block_pool::pop_magazine(atomic_128<u128>& list)
+{
+	u128 expected(list.load());
+
+	// Magazines are only freed along with their pool, so the head may be read even as it is popped elsewhere
+	while (job_block_magazine* const head = (job_block_magazine*)expected.m_u64[0]) {
+		const u128 desired((std::uint64_t)head->m_next.load(std::memory_order_relaxed), expected.m_u64[1] + 1);
+
+		if (list.compare_exchange_strong(expected, desired)) {
+			return head;
+		}
+	}
+
+	return nullptr;
+}
+}
+}
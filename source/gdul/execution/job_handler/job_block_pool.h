@@ -0,0 +1,135 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#include <gdul/execution/job_handler/globals.h>
+#include <gdul/execution/job_handler/job_handler_utility.h>
+#include <gdul/memory/pool_allocator.h>
+#include <gdul/memory/atomic_128.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace gdul {
+namespace jh_detail {
+
+enum job_block_slot : std::uint8_t
+{
+	job_block_slot_impl,
+	job_block_slot_node,
+	job_block_slot_count,
+};
+
+struct job_block_magazine
+{
+	// Link within the full / empty magazine lists
+	std::atomic<job_block_magazine*> m_next;
+	// Link within the list of all magazines of a pool, used to free them
+	job_block_magazine* m_nextAllocated;
+
+	std::uint32_t m_count;
+	std::array<void*, JobBlockMagazineSize> m_blocks;
+};
+
+struct job_block_cache
+{
+	~job_block_cache();
+
+	// Id of the job_block_pool the magazines belong to
+	std::uint64_t m_owner;
+	// Unpublished hits
+	std::uint32_t m_hits;
+
+	// Blocks are taken from and given to the loaded magazine. The previous one is always either full or empty
+	job_block_magazine* m_loaded;
+	job_block_magazine* m_previous;
+};
+
+// Front end to a shared pool, keeping two magazines of blocks per thread so that creating and destroying jobs 
+// mostly stays off the shared pool. Once both magazines run dry a full one is traded for an empty one with the 
+// pool's lists, and once both fill up a full one is traded for an empty one the other way, each exchange being 
+// a single CAS moving a whole magazine. Allocations are only served by the shared pool when no full magazine 
+// is available. Magazines are handed back to their owner when switching pools or as their thread exits, 
+// given that the owner is still alive
+class job_block_pool : public pa_detail::memory_pool_base
+{
+public:
+	using size_type = pa_detail::size_type;
+
+	job_block_pool(pool_allocator<std::uint8_t> shared, size_type itemSize, size_type itemAlign, job_block_slot slot, allocator_type allocator);
+	~job_block_pool();
+
+	job_block_pool(const job_block_pool&) = delete;
+	job_block_pool& operator=(const job_block_pool&) = delete;
+
+	// Returns the cached magazines to their owner
+	static void release(job_block_cache& cache);
+
+	void* get_block() override final;
+	void recycle_block(void* block) override final;
+
+	bool verify_compatibility(size_type itemSize, size_type itemAlign) const override final;
+
+	// Hits are published as a thread exchanges magazines with the pool, and so may lag behind
+	std::uint64_t hits() const noexcept;
+	std::uint64_t misses() const noexcept;
+
+private:
+	using magazine_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<job_block_magazine>;
+
+	job_block_cache& this_cache();
+
+	// An empty magazine, taken from the empty list or else allocated
+	job_block_magazine* make_magazine();
+
+	// Lists are tagged with an exchange count in the upper word, so that a magazine popped and pushed 
+	// back during a pop is not mistaken for an unchanged list
+	static void push_magazine(atomic_128<u128>& list, job_block_magazine* magazine);
+	static job_block_magazine* pop_magazine(atomic_128<u128>& list);
+
+	static thread_local std::array<job_block_cache, job_block_slot_count> t_caches;
+
+	pool_allocator<std::uint8_t> m_shared;
+
+	magazine_allocator_type m_allocator;
+
+	const size_type m_itemSize;
+	const size_type m_itemAlign;
+
+	const std::uint64_t m_id;
+
+	alignas(64) atomic_128<u128> m_fullMagazines;
+	alignas(64) atomic_128<u128> m_emptyMagazines;
+
+	alignas(64) std::atomic<job_block_magazine*> m_allMagazines;
+
+	alignas(64) std::atomic<std::uint64_t> m_hits;
+	std::atomic<std::uint64_t> m_misses;
+
+	const job_block_slot m_slot;
+};
+}
+}
+#pragma warning(pop)
@@ -35,8 +35,11 @@ job_handler::job_handler(jh_detail::allocator_type allocator)
 
 }
 void job_handler::init() {
+	init(job_handler_info());
+}
+void job_handler::init(const job_handler_info& info) {
 	jh_detail::allocator_type alloc(m_allocator);
-	m_impl = gdul::allocate_shared<jh_detail::job_handler_impl>(alloc, alloc);
+	m_impl = gdul::allocate_shared<jh_detail::job_handler_impl>(alloc, alloc, info);
 }
 job_handler::~job_handler()
 {
@@ -84,10 +87,103 @@ job job_handler::_redirect_make_job(std::size_t physicalId, [[maybe_unused]] con
 	return m_impl->make_job_internal(std::move(workUnit), target, physicalId, 0);
 #endif
 }
+batch_job job_handler::_redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, const std::string_view& dbgName)
+{
+	return _redirect_make_range_job(physicalId, dbgFile, line, begin, end, std::move(kernel), target, 0, dbgName);
+}
+batch_job job_handler::_redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, std::size_t variationId, const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_range_job_impl<jh_detail::range_kernel_type>;
+
+	// Shares pool with batch_job_impl
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Range job exceeds batch job pool block size");
+
+	assert(!(end < begin) && "Range end may not precede begin");
+
+	batch_grid grid;
+	grid.sizeX = end - begin;
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		begin,
+		grid,
+		std::move(kernel),
+		get_job_info(physicalId, variationId, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
+batch_job job_handler::_redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, const std::string_view& dbgName)
+{
+	return _redirect_make_range_job(physicalId, dbgFile, line, grid, std::move(kernel), target, 0, dbgName);
+}
+batch_job job_handler::_redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, std::size_t variationId, const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_range_job_impl<jh_detail::tile_kernel_type>;
+
+	// Shares pool with batch_job_impl
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Range job exceeds batch job pool block size");
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		std::size_t(0),
+		grid,
+		std::move(kernel),
+		get_job_info(physicalId, variationId, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
 std::size_t job_handler::worker_count() const noexcept
 {
 	return m_impl->worker_count();
 }
+worker_park_stats job_handler::get_park_stats() const noexcept
+{
+	return m_impl->get_park_stats();
+}
+job_pool_stats job_handler::get_pool_stats() const noexcept
+{
+	return m_impl->get_pool_stats();
+}
+job_handler_stats job_handler::collect_stats() const
+{
+	return m_impl->collect_stats();
+}
+void job_handler::set_tracing_enabled(bool enabled) noexcept
+{
+	m_impl->set_tracing_enabled(enabled);
+}
+void job_handler::collect_trace()
+{
+	m_impl->collect_trace();
+}
+bool job_handler::dump_trace(const std::string_view& file)
+{
+	return m_impl->dump_trace(file);
+}
+void job_handler::mark_trace_frame()
+{
+	m_impl->mark_trace_frame();
+}
+critical_path job_handler::analyse_critical_path(std::size_t frames)
+{
+	return m_impl->analyse_critical_path(frames);
+}
+bool job_handler::dump_critical_path(const std::string_view& file, std::size_t frames)
+{
+	return m_impl->dump_critical_path(file, frames);
+}
+bool job_handler::dump_job_recording(const std::string_view& file)
+{
+	return m_impl->dump_job_recording(file);
+}
 pool_allocator<std::uint8_t> job_handler::get_batch_job_allocator() const noexcept
 {
 	return m_impl->get_batch_job_allocator();
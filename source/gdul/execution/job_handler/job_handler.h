@@ -25,7 +25,12 @@
 #include <gdul/execution/job_handler/worker/worker.h>
 #include <gdul/execution/job_handler/job/job.h>
 #include <gdul/execution/job_handler/job/batch_job_impl.h>
+#include <gdul/execution/job_handler/job/batch_reduce_job_impl.h>
+#include <gdul/execution/job_handler/job/batch_sort_job_impl.h>
+#include <gdul/execution/job_handler/job/batch_partition_job_impl.h>
+#include <gdul/execution/job_handler/job/batch_range_job_impl.h>
 #include <gdul/execution/job_handler/job/batch_job.h>
+#include <gdul/execution/job_handler/tracking/critical_path.h>
 #include <gdul/utility/delegate.h>
 #include <gdul/memory/pool_allocator.h>
 
@@ -33,10 +38,16 @@
 
 #undef make_job
 #undef make_batch_job
+#undef make_reduce_job
+#undef make_range_job
 
 namespace gdul {
 namespace jh_detail {
 class job_handler_impl;
+
+// Selects the callable overloads of make_batch_job, leaving delegates to the delegate overloads
+template <class Process, class ...Args>
+using enable_if_batch_callable_t = std::enable_if_t<!is_delegate_v<Process> && std::is_invocable_v<Process&, Args...>>;
 }
 
 /// <summary>
@@ -68,6 +79,12 @@ public:
 	/// </summary>
 	void init();
 
+	/// <summary>
+	/// Initialize with options
+	/// </summary>
+	/// <param name="info">Initialization options</param>
+	void init(const job_handler_info& info);
+
 	/// <summary>
 	/// Destroy workers and de-initialize
 	/// </summary>
@@ -79,6 +96,81 @@ public:
 	/// <returns>Active workers</returns>
 	std::size_t worker_count() const noexcept;
 
+	/// <summary>
+	/// Query worker parking counters. Workers that have been idle for longer than their sleep threshhold are parked 
+	/// until new jobs are submitted
+	/// </summary>
+	/// <returns>Accumulated counters</returns>
+	worker_park_stats get_park_stats() const noexcept;
+
+	/// <summary>
+	/// Query job allocation counters. Jobs are allocated from per thread block caches, backed by a shared pool
+	/// </summary>
+	/// <returns>Accumulated counters</returns>
+	job_pool_stats get_pool_stats() const noexcept;
+
+	/// <summary>
+	/// Snapshot scheduler counters: push and pop counts and approximate depth of each queue assigned to a worker, 
+	/// along with per worker busy, idle, sleep and fetch times. Counters are kept per thread and only summed here, 
+	/// and so are cheap enough to leave running. Should not be called concurrently with make_worker
+	/// </summary>
+	/// <returns>Snapshot</returns>
+	job_handler_stats collect_stats() const;
+
+	/// <summary>
+	/// Toggle job tracing. While enabled, job enqueue, begin and end events are recorded to lock free per thread buffers. 
+	/// Available in release builds
+	/// </summary>
+	/// <param name="enabled">Tracing state</param>
+	void set_tracing_enabled(bool enabled) noexcept;
+
+	/// <summary>
+	/// Move recorded events out of the per thread buffers. May be called from any thread while jobs are running. 
+	/// Events are dropped once a thread's buffer is full, so this should be called regularly (such as once per frame) while tracing
+	/// </summary>
+	void collect_trace();
+
+	/// <summary>
+	/// Collect, then write traced events as Chrome trace event JSON, which may be viewed in chrome://tracing or Perfetto. 
+	/// Written events are cleared
+	/// </summary>
+	/// <param name="file">Output file path</param>
+	/// <returns>False if the file could not be opened</returns>
+	bool dump_trace(const std::string_view& file);
+
+	/// <summary>
+	/// Mark the start of a new frame in the trace. Recorded only while tracing is enabled
+	/// </summary>
+	void mark_trace_frame();
+
+	/// <summary>
+	/// Collect, then analyse the critical path of the last traced frames. Frames are separated by mark_trace_frame. 
+	/// Traced events up to the end of the last analysed frame are discarded, leaving those of the frame in progress. 
+	/// With fewer than two frame marks, the whole trace is analysed as one frame and events are left in place
+	/// </summary>
+	/// <param name="frames">Number of most recent complete frames to analyse</param>
+	/// <returns>Per frame nodes, edges, critical path and parallelism profile</returns>
+	critical_path analyse_critical_path(std::size_t frames);
+
+	/// <summary>
+	/// As analyse_critical_path, written as xml. Per job it lists slack, the frame time won should the job take 
+	/// no time, and the measured versus predicted time until its dependants finish. Also lists a parallelism profile 
+	/// per frame, and the jobs most worth speeding up across all frames
+	/// </summary>
+	/// <param name="file">Output file path</param>
+	/// <param name="frames">Number of most recent complete frames to analyse</param>
+	/// <returns>False if the file could not be opened</returns>
+	bool dump_critical_path(const std::string_view& file, std::size_t frames);
+
+	/// <summary>
+	/// Collect, then write traced job runs, their dependency edges and runtimes as a compact binary job_recording. 
+	/// Recordings may be loaded and replayed by job_simulator against other worker counts and queue policies, 
+	/// without a job_handler. Traced events are left in place
+	/// </summary>
+	/// <param name="file">Output file path</param>
+	/// <returns>False if the file could not be opened</returns>
+	bool dump_job_recording(const std::string_view& file);
+
 	/// <summary>
 	/// Creates a worker
 	/// </summary>
@@ -183,6 +275,149 @@ public:
 	template <class InContainer, class OutContainer>
 	batch_job make_batch_job(InContainer& input, OutContainer& output, delegate<bool(typename InContainer::value_type&, typename OutContainer::value_type&)> process, job_queue* target, std::size_t variationId, const std::string_view& dbgName = ""){ input; output; process; target; variationId; dbgName; /* See make_batch_job macro definition */ }
 
+	/// <summary>
+	/// Creates a batch job for splitting up processing of container elements, storing the processor by value so that it may be inlined into 
+	/// the per element loop. A processor returning bool reduces the container, as with the delegate overloads
+	/// </summary>
+	/// <typeparam name="InOutContainer">Container type. Requires size(), ::value_type and forward iterator. Also resize(), if the processor returns bool</typeparam>
+	/// <typeparam name="Process">Callable invocable with a value_type reference. Must fit the batch job pool block, as a delegate would</typeparam>
+	/// <param name="inputOutput">Input container value</param>
+	/// <param name="process">Processor called for each element</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	template <class InOutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InOutContainer::value_type&>* = nullptr>
+	batch_job make_batch_job(InOutContainer& inputOutput, Process process, job_queue* target, const std::string_view& dbgName = ""){ inputOutput; process; target; dbgName; /* See make_batch_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job for splitting up processing of container elements, storing the processor by value so that it may be inlined into 
+	/// the per element loop. A processor returning bool reduces the container, as with the delegate overloads
+	/// </summary>
+	/// <typeparam name="InOutContainer">Container type. Requires size(), ::value_type and forward iterator. Also resize(), if the processor returns bool</typeparam>
+	/// <typeparam name="Process">Callable invocable with a value_type reference. Must fit the batch job pool block, as a delegate would</typeparam>
+	/// <param name="inputOutput">Input container value</param>
+	/// <param name="process">Processor called for each element</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="variationId">Persistent identifier. Used to keep track of this physical job instantiation</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	template <class InOutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InOutContainer::value_type&>* = nullptr>
+	batch_job make_batch_job(InOutContainer& inputOutput, Process process, job_queue* target, std::size_t variationId, const std::string_view& dbgName = ""){ inputOutput; process; target; variationId; dbgName; /* See make_batch_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job for splitting up processing of container elements, storing the processor by value so that it may be inlined into 
+	/// the per element loop. Outputs the (potentially reduced) set of input items to a separate output container
+	/// </summary>
+	/// <typeparam name="InContainer">Container to be read from. Requires size(), ::value_type and forward iterator</typeparam>
+	/// <typeparam name="OutContainer">Container to be written to. Requires size(), resize(), ::value_type and forward iterator</typeparam>
+	/// <typeparam name="Process">Callable invocable with input and output value_type references, returning bool. Must fit the batch job pool block, as a delegate would</typeparam>
+	/// <param name="input">Input container value</param>
+	/// <param name="output">Output container value</param>
+	/// <param name="process">Processor called for each element. Returnvalue determines if element is to be included in the output container</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	template <class InContainer, class OutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InContainer::value_type&, typename OutContainer::value_type&>* = nullptr>
+	batch_job make_batch_job(InContainer& input, OutContainer& output, Process process, job_queue* target, const std::string_view& dbgName = ""){ input; output; process; target; dbgName; /* See make_batch_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job for splitting up processing of container elements, storing the processor by value so that it may be inlined into 
+	/// the per element loop. Outputs the (potentially reduced) set of input items to a separate output container
+	/// </summary>
+	/// <typeparam name="InContainer">Container to be read from. Requires size(), ::value_type and forward iterator</typeparam>
+	/// <typeparam name="OutContainer">Container to be written to. Requires size(), resize(), ::value_type and forward iterator</typeparam>
+	/// <typeparam name="Process">Callable invocable with input and output value_type references, returning bool. Must fit the batch job pool block, as a delegate would</typeparam>
+	/// <param name="input">Input container value</param>
+	/// <param name="output">Output container value</param>
+	/// <param name="process">Processor called for each element. Returnvalue determines if element is to be included in the output container</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="variationId">Persistent identifier. Used to keep track of this physical job instantiation</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	template <class InContainer, class OutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InContainer::value_type&, typename OutContainer::value_type&>* = nullptr>
+	batch_job make_batch_job(InContainer& input, OutContainer& output, Process process, job_queue* target, std::size_t variationId, const std::string_view& dbgName = ""){ input; output; process; target; variationId; dbgName; /* See make_batch_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job reducing container elements to a single value. Basically a parallel std::transform_reduce utilizing jobs. 
+	/// The result is read using batch_job::get_result&lt;Result&gt;() once finished
+	/// </summary>
+	/// <typeparam name="InContainer">Input container. Requires size(), ::value_type and forward iterator</typeparam>
+	/// <typeparam name="Result">Result type. Requires copy construction and assignment</typeparam>
+	/// <param name="input">Input container value</param>
+	/// <param name="identity">Initial value of each partial result. Must not affect the result when combined</param>
+	/// <param name="map">Called for each element, producing the value to be combined</param>
+	/// <param name="combine">Combines two values. Must be associative</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	template <class InContainer, class Result>
+	batch_job make_reduce_job(InContainer& input, const Result& identity, jh_detail::non_deduced_t<delegate<Result(typename InContainer::value_type&)>> map, jh_detail::non_deduced_t<delegate<Result(const Result&, const Result&)>> combine, job_queue* target, const std::string_view& dbgName = ""){ input; identity; map; combine; target; dbgName; /* See make_reduce_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job reducing container elements to a single value. Basically a parallel std::transform_reduce utilizing jobs. 
+	/// The result is read using batch_job::get_result&lt;Result&gt;() once finished
+	/// </summary>
+	/// <typeparam name="InContainer">Input container. Requires size(), ::value_type and forward iterator</typeparam>
+	/// <typeparam name="Result">Result type. Requires copy construction and assignment</typeparam>
+	/// <param name="input">Input container value</param>
+	/// <param name="identity">Initial value of each partial result. Must not affect the result when combined</param>
+	/// <param name="map">Called for each element, producing the value to be combined</param>
+	/// <param name="combine">Combines two values. Must be associative</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="variationId">Persistent identifier. Used to keep track of this physical job instantiation</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	template <class InContainer, class Result>
+	batch_job make_reduce_job(InContainer& input, const Result& identity, jh_detail::non_deduced_t<delegate<Result(typename InContainer::value_type&)>> map, jh_detail::non_deduced_t<delegate<Result(const Result&, const Result&)>> combine, job_queue* target, std::size_t variationId, const std::string_view& dbgName = ""){ input; identity; map; combine; target; variationId; dbgName; /* See make_reduce_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job splitting up the index range [begin, end) over jobs. The kernel is called once per job with a 
+	/// contiguous sub range, allowing tight (vectorizable) loops without a call per element
+	/// </summary>
+	/// <param name="begin">First index</param>
+	/// <param name="end">One past the last index</param>
+	/// <param name="kernel">Called with the [begin, end) sub range of each job</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	batch_job make_range_job(std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, const std::string_view& dbgName = ""){ begin; end; kernel; target; dbgName; /* See make_range_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job splitting up the index range [begin, end) over jobs. The kernel is called once per job with a 
+	/// contiguous sub range, allowing tight (vectorizable) loops without a call per element
+	/// </summary>
+	/// <param name="begin">First index</param>
+	/// <param name="end">One past the last index</param>
+	/// <param name="kernel">Called with the [begin, end) sub range of each job</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="variationId">Persistent identifier. Used to keep track of this physical job instantiation</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	batch_job make_range_job(std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, std::size_t variationId, const std::string_view& dbgName = ""){ begin; end; kernel; target; variationId; dbgName; /* See make_range_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job splitting up a 2D or 3D grid into tiles. Each job is handed a contiguous run of tiles, 
+	/// ordered x first, and calls the kernel once per tile
+	/// </summary>
+	/// <param name="grid">Grid and tile dimensions</param>
+	/// <param name="kernel">Called with the bounds of each tile</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	batch_job make_range_job(const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, const std::string_view& dbgName = ""){ grid; kernel; target; dbgName; /* See make_range_job macro definition */ }
+
+	/// <summary>
+	/// Creates a batch job splitting up a 2D or 3D grid into tiles. Each job is handed a contiguous run of tiles, 
+	/// ordered x first, and calls the kernel once per tile
+	/// </summary>
+	/// <param name="grid">Grid and tile dimensions</param>
+	/// <param name="kernel">Called with the bounds of each tile</param>
+	/// <param name="target">Target queue</param>
+	/// <param name="variationId">Persistent identifier. Used to keep track of this physical job instantiation</param>
+	/// <param name="dbgName">Job debug name</param>
+	/// <returns>New batch job</returns>
+	batch_job make_range_job(const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, std::size_t variationId, const std::string_view& dbgName = ""){ grid; kernel; target; variationId; dbgName; /* See make_range_job macro definition */ }
+
 #if defined (GDUL_JOB_DEBUG)
 	/// <summary>
 	/// Write the current job graph to a dgml file
@@ -231,6 +466,42 @@ public:
 	template <class InContainer, class OutContainer>
 	batch_job _redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, OutContainer& output, delegate<bool(typename InContainer::value_type&, typename OutContainer::value_type&)> process, job_queue* target, std::size_t variationId, const std::string_view& dbgName = "");
 
+	// Not for direct use
+	template <class InOutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InOutContainer::value_type&>* = nullptr>
+	batch_job _redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InOutContainer& inputOutput, Process process, job_queue* target, const std::string_view& dbgName = "");
+	// Not for direct use
+	template <class InOutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InOutContainer::value_type&>* = nullptr>
+	batch_job _redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InOutContainer& inputOutput, Process process, job_queue* target, std::size_t variationId, const std::string_view& dbgName = "");
+	// Not for direct use
+	template <class InContainer, class OutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InContainer::value_type&, typename OutContainer::value_type&>* = nullptr>
+	batch_job _redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, OutContainer& output, Process process, job_queue* target, const std::string_view& dbgName = "");
+	// Not for direct use
+	template <class InContainer, class OutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InContainer::value_type&, typename OutContainer::value_type&>* = nullptr>
+	batch_job _redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, OutContainer& output, Process process, job_queue* target, std::size_t variationId, const std::string_view& dbgName = "");
+
+	// Not for direct use
+	template <class InContainer, class Result>
+	batch_job _redirect_make_reduce_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, const Result& identity, jh_detail::non_deduced_t<delegate<Result(typename InContainer::value_type&)>> map, jh_detail::non_deduced_t<delegate<Result(const Result&, const Result&)>> combine, job_queue* target, const std::string_view& dbgName = "");
+	// Not for direct use
+	template <class InContainer, class Result>
+	batch_job _redirect_make_reduce_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, const Result& identity, jh_detail::non_deduced_t<delegate<Result(typename InContainer::value_type&)>> map, jh_detail::non_deduced_t<delegate<Result(const Result&, const Result&)>> combine, job_queue* target, std::size_t variationId, const std::string_view& dbgName = "");
+
+	// Not for direct use
+	batch_job _redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, const std::string_view& dbgName = "");
+	// Not for direct use
+	batch_job _redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, std::size_t variationId, const std::string_view& dbgName = "");
+	// Not for direct use
+	batch_job _redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, const std::string_view& dbgName = "");
+	// Not for direct use
+	batch_job _redirect_make_range_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, std::size_t variationId, const std::string_view& dbgName = "");
+
+	// Not for direct use. See parallel_sort
+	template <class Container, class Compare>
+	batch_job _redirect_make_sort_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, Container& container, Compare compare, job_queue* target, const std::string_view& dbgName = "");
+	// Not for direct use. See parallel_partition
+	template <class Container, class Predicate>
+	batch_job _redirect_make_partition_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, Container& container, Predicate predicate, job_queue* target, const std::string_view& dbgName = "");
+
 private:
 	template <class InContainer, class OutContainer, class Process>
 	friend class jh_detail::batch_job_impl;
@@ -315,6 +586,129 @@ inline batch_job job_handler::_redirect_make_batch_job(std::size_t physicalId, c
 
 	return batch_job(std::move(sp));
 }
+
+template<class InOutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InOutContainer::value_type&>*>
+inline batch_job job_handler::_redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InOutContainer& inputOutput, Process process, job_queue* target, const std::string_view& dbgName)
+{
+	return _redirect_make_batch_job(physicalId, dbgFile, line, inputOutput, std::move(process), target, 0, dbgName);
+}
+template<class InOutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InOutContainer::value_type&>*>
+inline batch_job job_handler::_redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InOutContainer& inputOutput, Process process, job_queue* target, std::size_t variationId, [[maybe_unused]] const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_job_impl<InOutContainer, InOutContainer, Process>;
+
+	// Shares pool with delegate based batch jobs
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Processor exceeds batch job pool block size. Consider capturing less or passing a delegate");
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		inputOutput,
+		inputOutput,
+		std::move(process),
+		get_job_info(physicalId, variationId, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
+template<class InContainer, class OutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InContainer::value_type&, typename OutContainer::value_type&>*>
+inline batch_job job_handler::_redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, OutContainer& output, Process process, job_queue* target, const std::string_view& dbgName)
+{
+	return _redirect_make_batch_job(physicalId, dbgFile, line, input, output, std::move(process), target, 0, dbgName);
+}
+template<class InContainer, class OutContainer, class Process, jh_detail::enable_if_batch_callable_t<Process, typename InContainer::value_type&, typename OutContainer::value_type&>*>
+inline batch_job job_handler::_redirect_make_batch_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, OutContainer& output, Process process, job_queue* target, std::size_t variationId, [[maybe_unused]] const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_job_impl<InContainer, OutContainer, Process>;
+
+	static_assert(std::is_same_v<bool, std::invoke_result_t<Process&, typename InContainer::value_type&, typename OutContainer::value_type&>>, "Input / output processor must return bool");
+
+	// Shares pool with delegate based batch jobs
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Processor exceeds batch job pool block size. Consider capturing less or passing a delegate");
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		input,
+		output,
+		std::move(process),
+		get_job_info(physicalId, variationId, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
+
+template<class InContainer, class Result>
+inline batch_job job_handler::_redirect_make_reduce_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, const Result& identity, jh_detail::non_deduced_t<delegate<Result(typename InContainer::value_type&)>> map, jh_detail::non_deduced_t<delegate<Result(const Result&, const Result&)>> combine, job_queue* target, const std::string_view& dbgName)
+{
+	return _redirect_make_reduce_job(physicalId, dbgFile, line, input, identity, std::move(map), std::move(combine), target, 0, dbgName);
+}
+template<class InContainer, class Result>
+inline batch_job job_handler::_redirect_make_reduce_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, InContainer& input, const Result& identity, jh_detail::non_deduced_t<delegate<Result(typename InContainer::value_type&)>> map, jh_detail::non_deduced_t<delegate<Result(const Result&, const Result&)>> combine, job_queue* target, std::size_t variationId, [[maybe_unused]] const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_reduce_job_impl<InContainer, Result>;
+
+	// Shares pool with batch_job_impl
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Reduce job exceeds batch job pool block size");
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		input,
+		identity,
+		std::move(map),
+		std::move(combine),
+		get_job_info(physicalId, variationId, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
+template<class Container, class Compare>
+inline batch_job job_handler::_redirect_make_sort_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, Container& container, Compare compare, job_queue* target, [[maybe_unused]] const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_sort_job_impl<Container, Compare>;
+
+	// Shares pool with batch_job_impl
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Sort job exceeds batch job pool block size");
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		container,
+		std::move(compare),
+		get_job_info(physicalId, 0, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
+template<class Container, class Predicate>
+inline batch_job job_handler::_redirect_make_partition_job(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, Container& container, Predicate predicate, job_queue* target, [[maybe_unused]] const std::string_view& dbgName)
+{
+	using batch_type = jh_detail::batch_partition_job_impl<Container, Predicate>;
+
+	// Shares pool with batch_job_impl
+	static_assert(!(gdul::allocate_shared_size<jh_detail::dummy_batch_type, pool_allocator<std::uint8_t>>() < gdul::allocate_shared_size<batch_type, pool_allocator<std::uint8_t>>()), "Partition job exceeds batch job pool block size");
+
+	pool_allocator<std::uint8_t> alloc(get_batch_job_allocator());
+
+	shared_ptr<batch_type> sp = gdul::allocate_shared<batch_type>(
+		alloc,
+		container,
+		std::move(predicate),
+		get_job_info(physicalId, 0, dbgName, dbgFile, line),
+		m_impl.get(),
+		target);
+
+	return batch_job(std::move(sp));
+}
 }
 
 #if  defined(_MSC_VER) || defined(__INTEL_COMPILER)
@@ -344,6 +738,10 @@ GDUL_INLINE_PRAGMA(warning(pop)) \
 // Signature 4:  gdul::batch_job (InOutContainer& inputOutput, delegate<bool(typename InOutContainer::value_type&)> process, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
 // Signature 5:  gdul::batch_job (InContainer& input, OutContainer& output, delegate<bool(typename InContainer::value_type&, typename OutContainer::value_type&)> process, job_queue* target, (opt) const std::string_view& dbgName)
 // Signature 6:  gdul::batch_job (InContainer& input, OutContainer& output, delegate<bool(typename InContainer::value_type&, typename OutContainer::value_type&)> process, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
+// Signature 7:  gdul::batch_job (InOutContainer& inputOutput, Process process, job_queue* target, (opt) const std::string_view& dbgName)
+// Signature 8:  gdul::batch_job (InOutContainer& inputOutput, Process process, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
+// Signature 9:  gdul::batch_job (InContainer& input, OutContainer& output, Process process, job_queue* target, (opt) const std::string_view& dbgName)
+// Signature 10: gdul::batch_job (InContainer& input, OutContainer& output, Process process, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
 #define make_batch_job(...) _redirect_make_batch_job( \
 GDUL_INLINE_PRAGMA(warning(push)) \
 GDUL_INLINE_PRAGMA(warning(disable : 4307)) \
@@ -351,4 +749,30 @@ gdul::jh_detail::constexp_str_hash(__FILE__) \
 GDUL_INLINE_PRAGMA(warning(pop)) \
 + std::size_t(__LINE__) \
 + std::size_t(__COUNTER__) \
+, __FILE__, __LINE__, __VA_ARGS__)
+
+
+// Signature 1:  gdul::batch_job (InContainer& input, const Result& identity, delegate<Result(typename InContainer::value_type&)> map, delegate<Result(const Result&, const Result&)> combine, job_queue* target, (opt) const std::string_view& dbgName)
+// Signature 2:  gdul::batch_job (InContainer& input, const Result& identity, delegate<Result(typename InContainer::value_type&)> map, delegate<Result(const Result&, const Result&)> combine, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
+#define make_reduce_job(...) _redirect_make_reduce_job( \
+GDUL_INLINE_PRAGMA(warning(push)) \
+GDUL_INLINE_PRAGMA(warning(disable : 4307)) \
+gdul::jh_detail::constexp_str_hash(__FILE__) \
+GDUL_INLINE_PRAGMA(warning(pop)) \
++ std::size_t(__LINE__) \
++ std::size_t(__COUNTER__) \
+, __FILE__, __LINE__, __VA_ARGS__)
+
+
+// Signature 1:  gdul::batch_job (std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, (opt) const std::string_view& dbgName)
+// Signature 2:  gdul::batch_job (std::size_t begin, std::size_t end, delegate<void(std::size_t, std::size_t)> kernel, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
+// Signature 3:  gdul::batch_job (const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, (opt) const std::string_view& dbgName)
+// Signature 4:  gdul::batch_job (const batch_grid& grid, delegate<void(const batch_tile&)> kernel, job_queue* target, std::size_t variationId, (opt) const std::string_view& dbgName)
+#define make_range_job(...) _redirect_make_range_job( \
+GDUL_INLINE_PRAGMA(warning(push)) \
+GDUL_INLINE_PRAGMA(warning(disable : 4307)) \
+gdul::jh_detail::constexp_str_hash(__FILE__) \
+GDUL_INLINE_PRAGMA(warning(pop)) \
++ std::size_t(__LINE__) \
++ std::size_t(__COUNTER__) \
 , __FILE__, __LINE__, __VA_ARGS__)
\ No newline at end of file
@@ -20,9 +20,13 @@
 
 #include <string>
 #include <thread>
+#include <algorithm>
 #include <gdul/execution/job_handler/job_handler_impl.h>
 #include <gdul/execution/job_handler/job_handler.h>
 #include <gdul/execution/thread/thread.h>
+#include <gdul/execution/thread/cpu_topology.h>
+#include <gdul/execution/job_handler/job_queue.h>
+#include <gdul/execution/job_handler/tracking/job_recording.h>
 
 namespace gdul
 {
@@ -37,21 +41,36 @@ job_handler_impl::job_handler_impl()
 }
 
 job_handler_impl::job_handler_impl(allocator_type allocator)
+	: job_handler_impl(allocator, job_handler_info())
+{
+}
+job_handler_impl::job_handler_impl(allocator_type allocator, const job_handler_info& info)
 	: m_jobImplMemPool()
 	, m_jobNodeMemPool()
 	, m_batchJobMemPool()
+	, m_jobImplBlocks()
+	, m_jobNodeBlocks()
 	, m_jobGraph(allocator)
-	, m_workers{}
+	, m_tracer(allocator)
+	, m_parking(allocator)
+	, m_timers(allocator, delegate<void()>(&job_handler_impl::wake_parked_worker, this))
+	, m_workers(allocator)
 	, m_workerIndices(0)
+	, m_info(info)
+	, m_initTime(std::chrono::steady_clock::now())
 	, m_mainAllocator(allocator)
 {
-	constexpr std::size_t jobImplAllocSize(allocate_shared_size<job_impl, pool_allocator<std::uint8_t>>());
-	constexpr std::size_t jobNodeAllocSize(allocate_shared_size<job_node, pool_allocator<std::uint8_t>>());
+	// Jobs and job nodes are reference counted intrusively (or not at all), and so need no control block
+	constexpr std::size_t jobImplAllocSize(sizeof(job_impl));
+	constexpr std::size_t jobNodeAllocSize(sizeof(job_node));
 	constexpr std::size_t batchJobAllocSize(allocate_shared_size<dummy_batch_type, pool_allocator<std::uint8_t>>());
 
 	m_jobImplMemPool.init<jobImplAllocSize, alignof(job_impl)>(JobPoolInitSize, 1, m_mainAllocator);
 	m_jobNodeMemPool.init<jobNodeAllocSize, alignof(job_node)>(JobPoolInitSize + jh_detail::BatchJobPoolInitSize, 1, m_mainAllocator);
 	m_batchJobMemPool.init<batchJobAllocSize, alignof(dummy_batch_type)>(BatchJobPoolInitSize, 1, m_mainAllocator);
+
+	m_jobImplBlocks = gdul::allocate_shared<job_block_pool>(m_mainAllocator, m_jobImplMemPool.create_allocator<std::uint8_t>(), jobImplAllocSize, alignof(job_impl), job_block_slot_impl, m_mainAllocator);
+	m_jobNodeBlocks = gdul::allocate_shared<job_block_pool>(m_mainAllocator, m_jobNodeMemPool.create_allocator<std::uint8_t>(), jobNodeAllocSize, alignof(job_node), job_block_slot_node, m_mainAllocator);
 }
 
 
@@ -64,6 +83,7 @@ void job_handler_impl::shutdown()
 {
 	const std::uint16_t workers(m_workerIndices.exchange(0, std::memory_order_seq_cst));
 
+	// Disabling a worker wakes it, should it be parked
 	for (size_t i = 0; i < workers; ++i) {
 		m_workers[i].disable();
 	}
@@ -74,71 +94,87 @@ worker job_handler_impl::make_worker()
 {
 	const std::uint16_t index(m_workerIndices.fetch_add(1, std::memory_order_relaxed));
 
+	// Storage must be in place before the thread starts looking for it
+	worker_impl& slot(m_workers.claim(index));
+	event_count& parking(m_parking.claim(index));
+
 	thread thread(&job_handler_impl::launch_worker, this, index);
 
-	jh_detail::worker_impl impl(std::move(thread));
+	std::uint16_t numaNode(Numa_Node_Unknown);
+
+	if (m_info.placement == worker_placement_core) {
+		const std::vector<std::uint16_t>& order(get_cpu_topology().placement_order());
+		const std::uint16_t core(order[index % order.size()]);
+
+		thread.set_core_affinity(std::vector<std::uint16_t>{ core });
+		numaNode = get_cpu_topology().numa_node_of(core);
+	}
+	else if (m_info.placement == worker_placement_numa_node) {
+		numaNode = (std::uint16_t)(index % get_cpu_topology().numa_node_count());
+
+		thread.set_core_affinity(get_cpu_topology().numa_node_cores(numaNode));
+	}
+
+	jh_detail::worker_impl impl(std::move(thread), &parking, &m_timers);
+	impl.set_numa_node(numaNode);
 
-	m_workers[index] = std::move(impl);
+	slot = std::move(impl);
 
-	return worker(&m_workers[index]);
+	return worker(&slot);
 }
 #if defined (GDUL_JOB_DEBUG)
 job job_handler_impl::make_job_internal(delegate<void()>&& workUnit, job_queue* target, std::size_t physicalId, std::size_t variationId, const std::string_view& name, const std::string_view& file, std::uint32_t line)
 {
-	pool_allocator<std::uint8_t> alloc(m_jobImplMemPool.create_allocator<std::uint8_t>());
+	pool_allocator<job_impl> alloc(get_job_impl_allocator());
 
-	job_impl_shared_ptr jobImpl(gdul::allocate_shared<job_impl>
+	job_impl* const jobImpl(new (alloc.allocate()) job_impl
 		(
-			alloc,
 			std::forward<delegate<void()>>(workUnit),
 			this,
 			target,
 			m_jobGraph.get_job_info(physicalId, variationId, name, file, line)));
 
-	return job(jobImpl);
+	return job(job_impl_ptr::adopt(jobImpl));
 }
 job job_handler_impl::make_sub_job_internal(delegate<void()>&& workUnit, job_queue* target, std::size_t batchId, std::size_t variationId, const std::string_view& name)
 {
-	pool_allocator<std::uint8_t> alloc(m_jobImplMemPool.create_allocator<std::uint8_t>());
+	pool_allocator<job_impl> alloc(get_job_impl_allocator());
 
-	job_impl_shared_ptr jobImpl(gdul::allocate_shared<job_impl>
+	job_impl* const jobImpl(new (alloc.allocate()) job_impl
 		(
-			alloc,
 			std::forward<delegate<void()>>(workUnit),
 			this,
 			target,
 			m_jobGraph.get_sub_job_info(batchId, variationId, name)));
 
-	return job(jobImpl);
+	return job(job_impl_ptr::adopt(jobImpl));
 }
 #else
 job job_handler_impl::make_job_internal(delegate<void()>&& workUnit, job_queue* target, std::size_t physicalId, std::size_t variationId)
 {
-	pool_allocator<std::uint8_t> alloc(m_jobImplMemPool.create_allocator<std::uint8_t>());
+	pool_allocator<job_impl> alloc(get_job_impl_allocator());
 
-	job_impl_shared_ptr jobImpl(gdul::allocate_shared<job_impl>
+	job_impl* const jobImpl(new (alloc.allocate()) job_impl
 		(
-			alloc,
 			std::forward<delegate<void()>>(workUnit),
 			this,
 			target,
 			m_jobGraph.get_job_info(physicalId, variationId)));
 
-	return job(jobImpl);
+	return job(job_impl_ptr::adopt(jobImpl));
 }
 job job_handler_impl::make_sub_job_internal(delegate<void()>&& workUnit, job_queue* target, std::size_t batchId, std::size_t variationId)
 {
-	pool_allocator<std::uint8_t> alloc(m_jobImplMemPool.create_allocator<std::uint8_t>());
+	pool_allocator<job_impl> alloc(get_job_impl_allocator());
 
-	job_impl_shared_ptr jobImpl(gdul::allocate_shared<job_impl>
+	job_impl* const jobImpl(new (alloc.allocate()) job_impl
 		(
-			alloc,
 			std::forward<delegate<void()>>(workUnit),
 			this,
 			target,
 			m_jobGraph.get_sub_job_info(batchId, variationId)));
 
-	return job(jobImpl);
+	return job(job_impl_ptr::adopt(jobImpl));
 }
 #endif
 std::size_t job_handler_impl::worker_count() const noexcept
@@ -151,9 +187,123 @@ job_graph& job_handler_impl::get_job_graph()
 	return m_jobGraph;
 }
 
+worker_park_stats job_handler_impl::get_park_stats() const noexcept
+{
+	worker_park_stats stats{};
+
+	const std::uint16_t workers(m_workerIndices.load(std::memory_order_acquire));
+
+	for (std::uint16_t i = 0; i < workers; ++i) {
+		const event_count& parking(m_parking[i]);
+
+		stats.parks += parking.park_count();
+		stats.wakes += parking.wake_count();
+		stats.timeouts += parking.timeout_count();
+	}
+
+	return stats;
+}
+job_pool_stats job_handler_impl::get_pool_stats() const noexcept
+{
+	const job_block_pool* const jobImplBlocks(static_cast<const job_block_pool*>(m_jobImplBlocks.get()));
+	const job_block_pool* const jobNodeBlocks(static_cast<const job_block_pool*>(m_jobNodeBlocks.get()));
+
+	job_pool_stats stats;
+	stats.hits = jobImplBlocks->hits() + jobNodeBlocks->hits();
+	stats.misses = jobImplBlocks->misses() + jobNodeBlocks->misses();
+
+	return stats;
+}
+job_handler_stats job_handler_impl::collect_stats() const
+{
+	job_handler_stats stats;
+	stats.time = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - m_initTime).count();
+	stats.park = get_park_stats();
+	stats.pool = get_pool_stats();
+
+	const std::uint16_t workers(m_workerIndices.load(std::memory_order_acquire));
+
+	std::vector<const job_queue*> queues;
+
+	for (std::uint16_t i = 0; i < workers; ++i) {
+		const worker_impl& wrk(m_workers[i]);
+
+		stats.workers.push_back(wrk.get_stats());
+
+		for (std::uint16_t j = 0; j < wrk.assignment_count(); ++j) {
+			const job_queue* const queue(wrk.get_assignment(j));
+
+			if (std::find(queues.begin(), queues.end(), queue) == queues.end()) {
+				queues.push_back(queue);
+				stats.queues.push_back(queue->get_stats());
+			}
+		}
+	}
+
+	return stats;
+}
+job_tracer& job_handler_impl::get_tracer() noexcept
+{
+	return m_tracer;
+}
+void job_handler_impl::set_tracing_enabled(bool enabled) noexcept
+{
+	m_tracer.set_enabled(enabled);
+}
+void job_handler_impl::collect_trace()
+{
+	m_tracer.collect();
+}
+bool job_handler_impl::dump_trace(const std::string_view& file)
+{
+	return m_tracer.dump_chrome_trace(file, m_jobGraph);
+}
+void job_handler_impl::mark_trace_frame()
+{
+	if (m_tracer.is_enabled()) {
+		m_tracer.record(job_trace_frame, nullptr);
+	}
+}
+critical_path job_handler_impl::analyse_critical_path(std::size_t frames)
+{
+	std::vector<job_trace_event> events;
+	m_tracer.copy_collected(events);
+
+	critical_path analysis;
+	analysis.analyse(events, frames, m_jobGraph);
+
+	// Events recorded since the copy all come after the last frame mark
+	if (const std::uint64_t until = analysis.analysed_until()) {
+		m_tracer.discard_collected(until);
+	}
+
+	return analysis;
+}
+bool job_handler_impl::dump_critical_path(const std::string_view& file, std::size_t frames)
+{
+	return analyse_critical_path(frames).dump(file, m_jobGraph);
+}
+bool job_handler_impl::dump_job_recording(const std::string_view& file)
+{
+	std::vector<job_trace_event> events;
+	m_tracer.copy_collected(events);
+
+	job_recording recording;
+	recording.build(events);
+
+	return recording.save(file);
+}
+job_timer_queue& job_handler_impl::get_timer_queue() noexcept
+{
+	return m_timers;
+}
+pool_allocator<std::uint8_t> job_handler_impl::get_job_impl_allocator() const noexcept
+{
+	return pool_allocator<std::uint8_t>(raw_ptr<pa_detail::memory_pool_base>(m_jobImplBlocks));
+}
 pool_allocator<std::uint8_t> job_handler_impl::get_job_node_allocator() const noexcept
 {
-	return m_jobNodeMemPool.create_allocator<std::uint8_t>();
+	return pool_allocator<std::uint8_t>(raw_ptr<pa_detail::memory_pool_base>(m_jobNodeBlocks));
 }
 pool_allocator<std::uint8_t> job_handler_impl::get_batch_job_allocator() const noexcept
 {
@@ -169,11 +319,27 @@ void job_handler_impl::dump_job_time_sets(const std::string_view& location)
 	m_jobGraph.dump_job_time_sets(location);
 }
 #endif
+void job_handler_impl::wake_parked_worker() noexcept
+{
+	const std::uint16_t workers(m_workerIndices.load(std::memory_order_acquire));
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	for (std::uint16_t i = 0; i < workers; ++i) {
+		if (event_count* const parking = m_parking.find(i)) {
+			if (parking->notify_fenced(1)) {
+				return;
+			}
+		}
+	}
+}
 void job_handler_impl::launch_worker(std::uint16_t index) noexcept
 {
 	t_items.this_worker_impl = &m_workers[index];
 	worker::this_worker = worker(t_items.this_worker_impl);
 
+	GDUL_JOB_DEBUG_CONDTIONAL(time_set::set_thread_worker_index(index))
+
 	while (!t_items.this_worker_impl->is_enabled()) {
 		t_items.this_worker_impl->idle();
 	}
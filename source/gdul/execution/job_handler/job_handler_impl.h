@@ -31,12 +31,17 @@
 #include <gdul/execution/job_handler/job/batch_job_impl.h>
 #include <gdul/execution/job_handler/worker/worker_impl.h>
 #include <gdul/execution/job_handler/worker/worker.h>
+#include <gdul/execution/job_handler/worker/event_count.h>
+#include <gdul/execution/job_handler/job_timer_queue.h>
+#include <gdul/execution/job_handler/job_block_pool.h>
 #include <gdul/execution/job_handler/job_handler_utility.h>
 #include <gdul/execution/job_handler/job/job_node.h>
 #include <gdul/execution/job_handler/tracking/job_graph.h>
+#include <gdul/execution/job_handler/tracking/critical_path.h>
+#include <gdul/execution/job_handler/tracking/job_tracer.h>
+#include <gdul/execution/job_handler/segmented_array.h>
 
 #include <string_view>
-#include <array>
 namespace gdul {
 
 class job_queue;
@@ -47,8 +52,6 @@ class job_impl;
 class job_handler_impl
 {
 public:
-	using job_impl_shared_ptr = job_impl::job_impl_shared_ptr;
-
 	struct tl_container
 	{
 		worker_impl* this_worker_impl;
@@ -57,6 +60,7 @@ public:
 
 	job_handler_impl();
 	job_handler_impl(allocator_type allocator);
+	job_handler_impl(allocator_type allocator, const job_handler_info& info);
 	~job_handler_impl();
 
  	void shutdown();
@@ -73,10 +77,28 @@ public:
 	std::size_t worker_count() const noexcept;
 
 	job_graph& get_job_graph();
+	job_tracer& get_tracer() noexcept;
+
+	worker_park_stats get_park_stats() const noexcept;
+
+	job_pool_stats get_pool_stats() const noexcept;
+
+	job_handler_stats collect_stats() const;
 
+	job_timer_queue& get_timer_queue() noexcept;
+
+	pool_allocator<std::uint8_t> get_job_impl_allocator() const noexcept;
 	pool_allocator<std::uint8_t> get_job_node_allocator() const noexcept;
 	pool_allocator<std::uint8_t> get_batch_job_allocator() const noexcept;
 
+	void set_tracing_enabled(bool enabled) noexcept;
+	void collect_trace();
+	bool dump_trace(const std::string_view& file);
+	void mark_trace_frame();
+	critical_path analyse_critical_path(std::size_t frames);
+	bool dump_critical_path(const std::string_view& file, std::size_t frames);
+	bool dump_job_recording(const std::string_view& file);
+
 #if defined(GDUL_JOB_DEBUG)
 	void dump_job_graph(const std::string_view& location);
 	void dump_job_time_sets(const std::string_view& location);
@@ -85,16 +107,34 @@ public:
 private:
 	void launch_worker(std::uint16_t index) noexcept;
 
+	// Wakes one parked worker, if any
+	void wake_parked_worker() noexcept;
+
 	memory_pool m_jobImplMemPool;
 	memory_pool m_jobNodeMemPool;
 	memory_pool m_batchJobMemPool;
 
+	// Per thread caches in front of the job and job node pools
+	shared_ptr<pa_detail::memory_pool_base> m_jobImplBlocks;
+	shared_ptr<pa_detail::memory_pool_base> m_jobNodeBlocks;
+
 	job_graph m_jobGraph;
 
-	std::array<worker_impl, MaxWorkers> m_workers;
+	job_tracer m_tracer;
+
+	// One per worker, by worker index. Claimed before the worker starts
+	segmented_array<event_count, WorkerBlockSize, allocator_type> m_parking;
+
+	job_timer_queue m_timers;
+
+	segmented_array<worker_impl, WorkerBlockSize, allocator_type> m_workers;
 
 	std::atomic<std::uint16_t> m_workerIndices;
 
+	job_handler_info m_info;
+
+	const std::chrono::steady_clock::time_point m_initTime;
+
 	allocator_type m_mainAllocator;
 };
 }
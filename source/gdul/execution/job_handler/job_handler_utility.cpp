@@ -21,19 +21,31 @@
 #include <gdul/execution/job_handler/job_handler_utility.h>
 #include <gdul/execution/job_handler/job_queue.h>
 
+#include <atomic>
+
 namespace gdul
 {
 namespace jh_detail
 {
 std::size_t to_batch_size(std::size_t inputSize, const job_queue* target)
 {
-	const std::uint8_t queueAssignees(target->assigned_workers());
-	const std::uint8_t div(queueAssignees ? queueAssignees : 1);
-	const std::uint8_t offset(div * 2);
-
-	const std::size_t desiredSize(inputSize / offset);
+	const std::size_t desiredSize(inputSize / to_batch_max_slices(target));
 
 	return desiredSize ? desiredSize : 1;
 }
+std::size_t to_batch_max_slices(const job_queue* target)
+{
+	const std::uint16_t queueAssignees(target->assigned_workers());
+	const std::size_t div(queueAssignees ? queueAssignees : 1);
+
+	return div * 2;
+}
+std::uint32_t this_counter_stripe() noexcept
+{
+	static std::atomic<std::uint32_t> s_stripes(0);
+	static thread_local const std::uint32_t t_stripe(s_stripes.fetch_add(1, std::memory_order_relaxed) % QueueCounterStripes);
+
+	return t_stripe;
+}
 }
 }
@@ -24,6 +24,8 @@
 
 #include <limits>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #if defined(GDUL_JOB_DEBUG)
 #define GDUL_JOB_DEBUG_CONDTIONAL(conditional)conditional;
@@ -37,6 +39,138 @@ class job_queue;
 
 typedef void* thread_handle;
 
+/// <summary>
+/// Worker placement policy, applied in make_worker
+/// </summary>
+enum worker_placement : std::uint8_t
+{
+	// Workers are left to the operating system scheduler
+	worker_placement_none,
+	// Workers are pinned 1:1 to cores in order of creation. Physical cores are used before SMT siblings 
+	// and cores are grouped by NUMA node. Wraps around if there are more workers than cores
+	worker_placement_core,
+	// Workers are distributed round robin over NUMA nodes and may be scheduled on any core within their node
+	worker_placement_numa_node,
+};
+
+/// <summary>
+/// Batch job slicing policy
+/// </summary>
+enum batch_partitioning : std::uint8_t
+{
+	// Input is split into equally sized slices as the batch job is created
+	batch_partitioning_static,
+	// Chunks are claimed from a shared cursor, shrinking as the input is consumed. The smallest chunk size is 
+	// derived from the item cost measured in previous runs of the same batch job
+	batch_partitioning_guided,
+};
+
+/// <summary>
+/// Index space of a tiled range job. Each dimension spans [0, size) and is cut into tiles of the given size. 
+/// Unused dimensions are left at 1
+/// </summary>
+struct batch_grid
+{
+	std::size_t sizeX = 1;
+	std::size_t sizeY = 1;
+	std::size_t sizeZ = 1;
+
+	std::size_t tileX = 1;
+	std::size_t tileY = 1;
+	std::size_t tileZ = 1;
+};
+
+/// <summary>
+/// Tile handed to a tiled range job kernel. Spans [begin, end) in each dimension, clamped to the grid size
+/// </summary>
+struct batch_tile
+{
+	std::size_t beginX;
+	std::size_t endX;
+	std::size_t beginY;
+	std::size_t endY;
+	std::size_t beginZ;
+	std::size_t endZ;
+};
+
+/// <summary>
+/// Job handler initialization options
+/// </summary>
+struct job_handler_info
+{
+	worker_placement placement = worker_placement_none;
+};
+
+/// <summary>
+/// Worker parking counters
+/// </summary>
+struct worker_park_stats
+{
+	// Times a worker has gone to sleep waiting for jobs
+	std::uint64_t parks;
+	// Workers woken by job submissions
+	std::uint64_t wakes;
+	// Parks that ran until the safety timeout
+	std::uint64_t timeouts;
+};
+
+/// <summary>
+/// Job allocation counters
+/// </summary>
+struct job_pool_stats
+{
+	// Job and job node allocations served from the allocating thread's magazines
+	std::uint64_t hits;
+	// Allocations that went to the shared pool, no full magazine being available
+	std::uint64_t misses;
+};
+
+/// <summary>
+/// Job queue counters
+/// </summary>
+struct job_queue_stats
+{
+	const job_queue* queue;
+	// Jobs submitted to the queue
+	std::uint64_t pushed;
+	// Jobs fetched from the queue by workers
+	std::uint64_t popped;
+	// Approximate number of jobs waiting in the queue
+	std::size_t depth;
+};
+
+/// <summary>
+/// Worker counters. Times are in seconds
+/// </summary>
+struct worker_stats
+{
+	// Jobs executed, including those run while waiting on other jobs
+	std::uint64_t jobsExecuted;
+	// Time spent running jobs
+	double busyTime;
+	// Time spent spinning or yielding while out of jobs
+	double idleTime;
+	// Time spent parked
+	double sleepTime;
+	// Time spent looking for jobs in assigned queues
+	double fetchTime;
+};
+
+/// <summary>
+/// Scheduler snapshot. Counters accumulate over the lifetime of the job handler, so rates are found 
+/// by comparing two snapshots
+/// </summary>
+struct job_handler_stats
+{
+	// Seconds since the job handler was initialized
+	double time;
+	// Queues assigned to workers
+	std::vector<job_queue_stats> queues;
+	std::vector<worker_stats> workers;
+	worker_park_stats park;
+	job_pool_stats pool;
+};
+
 namespace jh_detail
 {
 // https://stackoverflow.com/questions/48896142/is-it-possible-to-get-hash-values-as-compile-time-constants
@@ -55,9 +189,23 @@ constexpr std::size_t constexp_str_hash(const Str& toHash)
 
 constexpr std::uint32_t Job_Max_Dependencies = std::numeric_limits<std::uint32_t>::max() / 2;
 constexpr std::uint32_t Job_Enable_Dependencies = std::numeric_limits<std::uint32_t>::max() - Job_Max_Dependencies;
+constexpr std::size_t Job_Continuation_Id = constexp_str_hash(std::string_view("gdul::job continuation"));
 
 using allocator_type = std::allocator<uint8_t>;
 
+// Keeps a template parameter from being deduced from an argument, such as when the argument is a lambda
+template <class T>
+struct non_deduced { using type = T; };
+template <class T>
+using non_deduced_t = typename non_deduced<T>::type;
+
 std::size_t to_batch_size(std::size_t inputSize, const job_queue* target);
+std::size_t to_batch_max_slices(const job_queue* target);
+
+// Counter stripe of the calling thread, in [0, QueueCounterStripes)
+std::uint32_t this_counter_stripe() noexcept;
+
+// NUMA node of the calling worker (or the node of the current core, for threads that are not workers)
+std::uint16_t this_numa_node() noexcept;
 }
 }
\ No newline at end of file
@@ -20,39 +20,442 @@
 
 #include "job_queue.h"
 #include <gdul/execution/job_handler/job/job_impl.h>
+#include <gdul/execution/job_handler/job_handler_impl.h>
+#include <gdul/execution/job_handler/worker/event_count.h>
+#include <gdul/execution/thread/cpu_topology.h>
+
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
 
 namespace gdul {
+namespace jh_detail {
+constexpr std::uint16_t Ws_Slot_Unclaimed = std::numeric_limits<std::uint16_t>::max();
+constexpr std::uint16_t Ws_Slot_Exhausted = Ws_Slot_Unclaimed - 1;
 
-void job_async_queue::submit_job(jh_detail::job_impl_shared_ptr jb)
+std::uint32_t next_victim_seed() noexcept
+{
+	static thread_local std::uint32_t t_seed(std::uint32_t(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u);
+
+	t_seed ^= t_seed << 13;
+	t_seed ^= t_seed >> 17;
+	t_seed ^= t_seed << 5;
+
+	return t_seed;
+}
+}
+
+void job_async_queue::push_job(jh_detail::job_impl_ptr jb)
 {
 	m_queue.push(std::move(jb));
 }
+void job_async_queue::push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count)
+{
+	m_queue.push_bulk(std::make_move_iterator(jobs), (decltype(m_queue)::size_type)count);
+}
 job_async_queue::job_async_queue(jh_detail::allocator_type alloc)
 	: m_queue(alloc)
 {
 }
-jh_detail::job_impl_shared_ptr job_async_queue::fetch_job()
+jh_detail::job_impl_ptr job_async_queue::fetch_job()
 {
-	jh_detail::job_impl_shared_ptr out;
+	jh_detail::job_impl_ptr out;
 	m_queue.try_pop(out);
 	return out;
 }
+std::size_t job_async_queue::approximate_size() const
+{
+	return m_queue.size();
+}
 job_sync_queue::job_sync_queue(jh_detail::allocator_type alloc)
 	: m_queue(alloc)
 {
 }
-void job_sync_queue::submit_job(jh_detail::job_impl_shared_ptr jb)
+void job_sync_queue::push_job(jh_detail::job_impl_ptr jb)
 {
 	m_queue.push(std::make_pair(jb->get_remaining_dependant_time(), std::move(jb)));
 }
-jh_detail::job_impl_shared_ptr job_sync_queue::fetch_job()
+void job_sync_queue::push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count)
+{
+	// Each node is linked on its own. Concurrent insertions into the skip list are version checked per link,
+	// leaving no safe way of splicing in a presorted run
+	for (std::size_t i = 0; i < count; ++i) {
+		push_job(std::move(jobs[i]));
+	}
+}
+jh_detail::job_impl_ptr job_sync_queue::fetch_job()
 {
-	std::pair<float, jh_detail::job_impl_shared_ptr> out;
+	std::pair<float, jh_detail::job_impl_ptr> out;
 	m_queue.try_pop(out);
-	return out.second;
+	return std::move(out.second);
+}
+job_relaxed_sync_queue::job_relaxed_sync_queue()
+	: job_relaxed_sync_queue(jh_detail::allocator_type())
+{
+}
+job_relaxed_sync_queue::job_relaxed_sync_queue(jh_detail::allocator_type alloc)
+	: m_allocator(alloc)
+	, m_buckets(nullptr)
+	, m_occupied(0)
+{
+	m_buckets = m_allocator.allocate(jh_detail::RelaxedSyncQueueBuckets);
+
+	for (std::uint8_t i = 0; i < jh_detail::RelaxedSyncQueueBuckets; ++i) {
+		new (&m_buckets[i]) queue_type(alloc);
+	}
+}
+job_relaxed_sync_queue::~job_relaxed_sync_queue()
+{
+	for (std::uint8_t i = 0; i < jh_detail::RelaxedSyncQueueBuckets; ++i) {
+		m_buckets[i].~queue_type();
+	}
+
+	m_allocator.deallocate(m_buckets, jh_detail::RelaxedSyncQueueBuckets);
+}
+void job_relaxed_sync_queue::push_job(jh_detail::job_impl_ptr jb)
+{
+	const std::uint8_t bucket(to_bucket(jb->get_remaining_dependant_time()));
+	const std::uint32_t bit(1u << bucket);
+
+	m_buckets[bucket].push(std::move(jb));
+
+	// Pairs with the fence in fetch_job, so that either the consumer finds the job or we find the bit cleared
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (!(m_occupied.load(std::memory_order_relaxed) & bit)) {
+		m_occupied.fetch_or(bit, std::memory_order_relaxed);
+	}
+}
+jh_detail::job_impl_ptr job_relaxed_sync_queue::fetch_job()
+{
+	std::uint32_t occupied(m_occupied.load(std::memory_order_relaxed));
+
+	jh_detail::job_impl_ptr out;
+
+	for (std::uint8_t bucket = jh_detail::RelaxedSyncQueueBuckets; occupied && bucket--;) {
+		const std::uint32_t bit(1u << bucket);
+
+		if (!(occupied & bit)) {
+			continue;
+		}
+
+		if (m_buckets[bucket].try_pop(out)) {
+			return out;
+		}
+
+		m_occupied.fetch_and(~bit, std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// A job may have been pushed after the first attempt, but before its producer saw the bit cleared
+		if (m_buckets[bucket].try_pop(out)) {
+			m_occupied.fetch_or(bit, std::memory_order_relaxed);
+			return out;
+		}
+
+		occupied &= ~bit;
+	}
+
+	return out;
+}
+std::size_t job_relaxed_sync_queue::approximate_size() const
+{
+	std::size_t size(0);
+
+	for (std::uint8_t i = 0; i < jh_detail::RelaxedSyncQueueBuckets; ++i) {
+		size += m_buckets[i].size();
+	}
+
+	return size;
+}
+std::uint8_t job_relaxed_sync_queue::to_bucket(float priority) noexcept
+{
+	if (!(0.f < priority)) {
+		return 0;
+	}
+
+	const std::int32_t bucket(std::ilogb(priority) - jh_detail::RelaxedSyncQueueMinExponent);
+
+	return (std::uint8_t)std::clamp<std::int32_t>(bucket, 0, jh_detail::RelaxedSyncQueueBuckets - 1);
+}
+job_work_stealing_queue::job_work_stealing_queue()
+	: job_work_stealing_queue(jh_detail::allocator_type())
+{
+}
+job_work_stealing_queue::job_work_stealing_queue(jh_detail::allocator_type alloc)
+	: m_deques(alloc)
+	, m_slotNodes(alloc)
+	, m_injector(alloc)
+	, t_slot(alloc, jh_detail::Ws_Slot_Unclaimed)
+	, m_slots(0)
+	, m_allocator(alloc)
+{
+}
+job_work_stealing_queue::~job_work_stealing_queue()
+{
+	const std::uint16_t slots(std::min<std::uint16_t>(m_slots.load(std::memory_order_acquire), jh_detail::Ws_Slot_Exhausted));
+
+	for (std::uint16_t i = 0; i < slots; ++i) {
+		while (jh_detail::job_impl* const jb = m_deques[i].steal()) {
+			jh_detail::job_impl_ptr::adopt(jb).reset();
+		}
+	}
+}
+void job_work_stealing_queue::push_job(jh_detail::job_impl_ptr jb)
+{
+	const std::uint16_t slot(t_slot);
+
+	if (slot < jh_detail::Ws_Slot_Exhausted) {
+		// The deque holds on to the reference until the job is popped or stolen
+		m_deques[slot].push(jb.detach());
+	}
+	else {
+		m_injector.push(std::move(jb));
+	}
+}
+jh_detail::job_impl_ptr job_work_stealing_queue::fetch_job()
+{
+	const std::uint16_t slot(claim_slot());
+
+	if (slot < jh_detail::Ws_Slot_Exhausted) {
+		if (jh_detail::job_impl* const jb = m_deques[slot].pop()) {
+			return jh_detail::job_impl_ptr::adopt(jb);
+		}
+	}
+
+	jh_detail::job_impl_ptr out;
+	if (m_injector.try_pop(out)) {
+		return out;
+	}
+
+	return steal_job(slot);
+}
+jh_detail::job_impl_ptr job_work_stealing_queue::steal_job(std::uint16_t thiefSlot)
+{
+	const std::uint16_t slots(std::min<std::uint16_t>(m_slots.load(std::memory_order_acquire), jh_detail::Ws_Slot_Exhausted));
+
+	if (!slots) {
+		return jh_detail::job_impl_ptr(nullptr);
+	}
+
+	const std::uint16_t first(std::uint16_t(jh_detail::next_victim_seed() % slots));
+
+	// First pass only visits victims on the thief's own NUMA node
+	const bool multiNode(1 < get_cpu_topology().numa_node_count());
+	const std::uint16_t thiefNode(multiNode ? jh_detail::this_numa_node() : 0);
+
+	for (std::uint8_t pass = multiNode ? 0 : 1; pass < 2; ++pass) {
+		for (std::uint16_t i = 0; i < slots; ++i) {
+			const std::uint16_t victim((first + i) % slots);
+
+			if (victim == thiefSlot) {
+				continue;
+			}
+			// Victim may have been counted but not yet have its storage in place
+			jh_detail::work_stealing_deque* const deque(m_deques.find(victim));
+			std::atomic<std::uint16_t>* const node(m_slotNodes.find(victim));
+
+			if (!deque || !node) {
+				continue;
+			}
+			if (!pass && node->load(std::memory_order_relaxed) != thiefNode) {
+				continue;
+			}
+
+			if (jh_detail::job_impl* const jb = deque->steal()) {
+				return jh_detail::job_impl_ptr::adopt(jb);
+			}
+		}
+	}
+
+	return jh_detail::job_impl_ptr(nullptr);
+}
+std::uint16_t job_work_stealing_queue::claim_slot()
+{
+	std::uint16_t& slot(t_slot);
+
+	if (slot == jh_detail::Ws_Slot_Unclaimed) {
+		const std::uint16_t claimed(m_slots.load(std::memory_order_relaxed) < jh_detail::Ws_Slot_Exhausted ? m_slots.fetch_add(1, std::memory_order_relaxed) : jh_detail::Ws_Slot_Exhausted);
+
+		if (claimed < jh_detail::Ws_Slot_Exhausted) {
+			m_slotNodes.claim(claimed).store(jh_detail::this_numa_node(), std::memory_order_relaxed);
+			m_deques.claim(claimed).init(m_allocator);
+			slot = claimed;
+		}
+		else {
+			slot = jh_detail::Ws_Slot_Exhausted;
+		}
+	}
+
+	return slot;
+}
+job_numa_queue::job_numa_queue()
+	: job_numa_queue(jh_detail::allocator_type())
+{
+}
+job_numa_queue::job_numa_queue(jh_detail::allocator_type alloc)
+	: m_allocator(alloc)
+	, m_queues(nullptr)
+	, m_nodes((std::uint16_t)get_cpu_topology().numa_node_count())
+{
+	m_queues = m_allocator.allocate(m_nodes);
+
+	for (std::uint16_t i = 0; i < m_nodes; ++i) {
+		new (&m_queues[i]) queue_type(alloc);
+	}
+}
+job_numa_queue::~job_numa_queue()
+{
+	for (std::uint16_t i = 0; i < m_nodes; ++i) {
+		m_queues[i].~queue_type();
+	}
+
+	m_allocator.deallocate(m_queues, m_nodes);
 }
-std::uint8_t job_queue::assigned_workers() const
+void job_numa_queue::push_job(jh_detail::job_impl_ptr jb)
+{
+	const std::uint16_t node(jh_detail::this_numa_node() % m_nodes);
+
+	m_queues[node].push(std::move(jb));
+}
+void job_numa_queue::push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count)
+{
+	const std::uint16_t node(jh_detail::this_numa_node() % m_nodes);
+
+	m_queues[node].push_bulk(std::make_move_iterator(jobs), (queue_type::size_type)count);
+}
+jh_detail::job_impl_ptr job_numa_queue::fetch_job()
+{
+	const std::uint16_t node(jh_detail::this_numa_node() % m_nodes);
+
+	jh_detail::job_impl_ptr out;
+
+	for (std::uint16_t i = 0; i < m_nodes; ++i) {
+		if (m_queues[(node + i) % m_nodes].try_pop(out)) {
+			break;
+		}
+	}
+
+	return out;
+}
+std::size_t job_numa_queue::approximate_size() const
+{
+	std::size_t size(0);
+
+	for (std::uint16_t i = 0; i < m_nodes; ++i) {
+		size += m_queues[i].size();
+	}
+
+	return size;
+}
+void job_queue::submit_job(jh_detail::job_impl_ptr jb)
+{
+	jh_detail::job_tracer& tracer(jb->get_handler()->get_tracer());
+	if (tracer.is_enabled()) {
+		tracer.record(jh_detail::job_trace_enqueue, jb.get());
+	}
+
+	m_counters[jh_detail::this_counter_stripe()].m_pushed.fetch_add(1, std::memory_order_relaxed);
+
+	push_job(std::move(jb));
+
+	notify_assignees(1);
+}
+void job_queue::submit_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count)
+{
+	if (!count) {
+		return;
+	}
+
+	jh_detail::job_tracer& tracer(jobs[0]->get_handler()->get_tracer());
+	if (tracer.is_enabled()) {
+		for (std::size_t i = 0; i < count; ++i) {
+			tracer.record(jh_detail::job_trace_enqueue, jobs[i].get());
+		}
+	}
+
+	m_counters[jh_detail::this_counter_stripe()].m_pushed.fetch_add(count, std::memory_order_relaxed);
+
+	push_jobs(jobs, count);
+
+	notify_assignees(count);
+}
+void job_queue::push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count)
+{
+	for (std::size_t i = 0; i < count; ++i) {
+		push_job(std::move(jobs[i]));
+	}
+}
+jh_detail::job_impl_ptr job_queue::take_job()
+{
+	jh_detail::job_impl_ptr jb(fetch_job());
+
+	if (jb) {
+		m_counters[jh_detail::this_counter_stripe()].m_popped.fetch_add(1, std::memory_order_release);
+	}
+
+	return jb;
+}
+std::size_t job_queue::approximate_size() const
+{
+	const job_queue_stats stats(count_stats());
+
+	return (std::size_t)(stats.pushed - stats.popped);
+}
+void job_queue::notify_assignees(std::size_t n)
+{
+	const std::uint16_t assignees(m_assignees.load(std::memory_order_acquire));
+
+	if (!assignees) {
+		return;
+	}
+
+	// Pairs with the announcement in event_count::prepare_wait. A parking worker either finds the pushed jobs, or is seen waiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	const std::uint16_t first(m_wakeCursor.load(std::memory_order_relaxed));
+	m_wakeCursor.store((std::uint16_t)(first + 1), std::memory_order_relaxed);
+
+	for (std::uint16_t i = 0; i < assignees && n; ++i) {
+		std::atomic<jh_detail::event_count*>* const slot(m_parkings.find((first + i) % assignees));
+
+		if (!slot) {
+			continue;
+		}
+		if (jh_detail::event_count* const parking = slot->load(std::memory_order_acquire)) {
+			n -= parking->notify_fenced((std::uint32_t)std::min<std::size_t>(n, std::numeric_limits<std::uint32_t>::max()));
+		}
+	}
+}
+std::uint16_t job_queue::assigned_workers() const
 {
 	return m_assignees.load(std::memory_order_relaxed);
 }
+job_queue_stats job_queue::get_stats() const
+{
+	job_queue_stats stats(count_stats());
+	stats.depth = approximate_size();
+
+	return stats;
+}
+job_queue_stats job_queue::count_stats() const
+{
+	job_queue_stats stats;
+	stats.queue = this;
+	stats.pushed = 0;
+	stats.popped = 0;
+	stats.depth = 0;
+
+	// Jobs are counted as pushed before they may be popped, so reading pops first keeps pushed from lagging behind
+	for (const counter_stripe& stripe : m_counters) {
+		stats.popped += stripe.m_popped.load(std::memory_order_acquire);
+	}
+	for (const counter_stripe& stripe : m_counters) {
+		stats.pushed += stripe.m_pushed.load(std::memory_order_relaxed);
+	}
+
+	return stats;
+}
 }
\ No newline at end of file
@@ -20,10 +20,18 @@
 
 #pragma once
 
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
 #include <gdul/execution/job_handler/job/job.h>
 #include <gdul/execution/job_handler/globals.h>
 #include <gdul/containers/concurrent_priority_queue.h>
 #include <gdul/containers/concurrent_queue.h>
+#include <gdul/memory/thread_local_member.h>
+#include <gdul/execution/job_handler/work_stealing_deque.h>
+#include <gdul/execution/job_handler/segmented_array.h>
+
+#include <array>
 
 namespace gdul {
 	
@@ -31,7 +39,8 @@ class job;
 class job_handler;
 namespace jh_detail {
 class job_impl;
-using job_impl_shared_ptr = shared_ptr<job_impl>;
+class job_release_batch;
+class event_count;
 }
 
 /// <summary>
@@ -42,16 +51,56 @@ class job_queue
 public:
 	virtual ~job_queue() = default;
 
-	std::uint8_t assigned_workers() const;
+	std::uint16_t assigned_workers() const;
+
+	/// <summary>
+	/// Query push and pop counters, along with an approximate depth
+	/// </summary>
+	/// <returns>Accumulated counters</returns>
+	job_queue_stats get_stats() const;
+
 private:
 	friend class job;
 	friend class jh_detail::job_impl;
+	friend class jh_detail::job_release_batch;
 	friend class jh_detail::worker_impl;
 
-	virtual jh_detail::job_impl_shared_ptr fetch_job() = 0;
-	virtual void submit_job(jh_detail::job_impl_shared_ptr jb) = 0;
+	void submit_job(jh_detail::job_impl_ptr jb);
+
+	// Submits count jobs, moving from jobs. Workers are notified once for the whole set
+	void submit_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count);
+
+	// Fetches a job on behalf of a worker, counting it as popped
+	jh_detail::job_impl_ptr take_job();
+
+	virtual jh_detail::job_impl_ptr fetch_job() = 0;
+	virtual void push_job(jh_detail::job_impl_ptr jb) = 0;
+	virtual void push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count);
+
+	// Defaults to the difference between push and pop counters
+	virtual std::size_t approximate_size() const;
 
-	std::atomic_uint8_t m_assignees = 0;
+	// Sums counter stripes, leaving out depth
+	job_queue_stats count_stats() const;
+
+	// Wakes up to n parked workers assigned to this queue
+	void notify_assignees(std::size_t n);
+
+	struct alignas(64) counter_stripe
+	{
+		std::atomic<std::uint64_t> m_pushed = 0;
+		std::atomic<std::uint64_t> m_popped = 0;
+	};
+
+	std::array<counter_stripe, jh_detail::QueueCounterStripes> m_counters;
+
+	// Event counts of assigned workers, by order of assignment. Entries are null until set by the assigning thread
+	jh_detail::segmented_array<std::atomic<jh_detail::event_count*>, jh_detail::WorkerBlockSize, jh_detail::allocator_type> m_parkings;
+
+	std::atomic_uint16_t m_assignees = 0;
+
+	// First assignee considered for waking, rotated so that wakes spread over assignees
+	std::atomic_uint16_t m_wakeCursor = 0;
 };
 
 /// <summary>
@@ -67,11 +116,12 @@ public:
 
 
 private:
-	void submit_job(jh_detail::job_impl_shared_ptr jb) override final;
-	jh_detail::job_impl_shared_ptr fetch_job() override final;
-
+	void push_job(jh_detail::job_impl_ptr jb) override final;
+	void push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count) override final;
+	jh_detail::job_impl_ptr fetch_job() override final;
+	std::size_t approximate_size() const override final;
 
-	concurrent_queue<jh_detail::job_impl_shared_ptr, jh_detail::allocator_type> m_queue;
+	concurrent_queue<jh_detail::job_impl_ptr, jh_detail::allocator_type> m_queue;
 };
 
 /// <summary>
@@ -85,9 +135,103 @@ public:
 	job_sync_queue(jh_detail::allocator_type alloc);
 
 private:
-	void submit_job(jh_detail::job_impl_shared_ptr jb) override final;
-	jh_detail::job_impl_shared_ptr fetch_job() override final;
+	void push_job(jh_detail::job_impl_ptr jb) override final;
+	void push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count) override final;
+	jh_detail::job_impl_ptr fetch_job() override final;
+
+	concurrent_priority_queue<float, jh_detail::job_impl_ptr, jh_detail::JobPoolInitSize, cpq_allocation_strategy_pool<jh_detail::allocator_type>, std::greater<float>> m_queue;
+};
+
+/// <summary>
+/// Relaxed alternative to job_sync_queue. Jobs are placed in FIFO buckets by the log2 of their remaining 
+/// dependant time, and consumers take from the highest occupied bucket. Critical path jobs are still 
+/// preferred, while pushing and popping costs little more than for job_async_queue. Ordering within a bucket is FIFO
+/// </summary>
+class job_relaxed_sync_queue : public job_queue
+{
+public:
+	job_relaxed_sync_queue();
+	job_relaxed_sync_queue(jh_detail::allocator_type alloc);
+	~job_relaxed_sync_queue();
+
+private:
+	using queue_type = concurrent_queue<jh_detail::job_impl_ptr, jh_detail::allocator_type>;
+	using queue_allocator_type = typename std::allocator_traits<jh_detail::allocator_type>::template rebind_alloc<queue_type>;
+
+	static_assert(!(32 < jh_detail::RelaxedSyncQueueBuckets), "Bucket occupancy is tracked in 32 bits");
+
+	void push_job(jh_detail::job_impl_ptr jb) override final;
+	jh_detail::job_impl_ptr fetch_job() override final;
+	std::size_t approximate_size() const override final;
+
+	static std::uint8_t to_bucket(float priority) noexcept;
+
+	queue_allocator_type m_allocator;
+
+	queue_type* m_buckets;
 
-	concurrent_priority_queue<float, jh_detail::job_impl_shared_ptr, jh_detail::JobPoolInitSize, cpq_allocation_strategy_pool<jh_detail::allocator_type>, std::greater<float>> m_queue;
+	// Set as jobs are pushed, and cleared by consumers finding a bucket empty
+	std::atomic<std::uint32_t> m_occupied;
 };
-}
\ No newline at end of file
+
+/// <summary>
+/// Queue where each consuming thread owns a local deque. Jobs submitted from a consuming thread 
+/// (such as dependants released by a finishing job) are pushed to that thread's deque and consumed in 
+/// LIFO order. Idle consumers steal from random victims, preferring those on the same NUMA node. 
+/// Jobs submitted from other threads are placed in a shared injection queue
+/// </summary>
+class job_work_stealing_queue : public job_queue
+{
+public:
+	job_work_stealing_queue();
+	job_work_stealing_queue(jh_detail::allocator_type alloc);
+	~job_work_stealing_queue();
+
+private:
+	void push_job(jh_detail::job_impl_ptr jb) override final;
+	jh_detail::job_impl_ptr fetch_job() override final;
+
+	jh_detail::job_impl_ptr steal_job(std::uint16_t thiefSlot);
+
+	std::uint16_t claim_slot();
+
+	jh_detail::segmented_array<jh_detail::work_stealing_deque, jh_detail::WorkerBlockSize, jh_detail::allocator_type> m_deques;
+	jh_detail::segmented_array<std::atomic<std::uint16_t>, jh_detail::WorkerBlockSize, jh_detail::allocator_type> m_slotNodes;
+
+	concurrent_queue<jh_detail::job_impl_ptr, jh_detail::allocator_type> m_injector;
+
+	tlm<std::uint16_t, jh_detail::allocator_type> t_slot;
+
+	std::atomic<std::uint16_t> m_slots;
+
+	jh_detail::allocator_type m_allocator;
+};
+
+/// <summary>
+/// Relaxed FIFO queue split per NUMA node. Jobs are placed in the sub queue of the submitting thread's node
+/// and consumers prefer their own node, only taking jobs from other nodes when their own is empty
+/// </summary>
+class job_numa_queue : public job_queue
+{
+public:
+	job_numa_queue();
+	job_numa_queue(jh_detail::allocator_type alloc);
+	~job_numa_queue();
+
+private:
+	using queue_type = concurrent_queue<jh_detail::job_impl_ptr, jh_detail::allocator_type>;
+	using queue_allocator_type = typename std::allocator_traits<jh_detail::allocator_type>::template rebind_alloc<queue_type>;
+
+	void push_job(jh_detail::job_impl_ptr jb) override final;
+	void push_jobs(jh_detail::job_impl_ptr* jobs, std::size_t count) override final;
+	jh_detail::job_impl_ptr fetch_job() override final;
+	std::size_t approximate_size() const override final;
+
+	queue_allocator_type m_allocator;
+
+	queue_type* m_queues;
+	std::uint16_t m_nodes;
+};
+}
+
+#pragma warning(pop)
@@ -0,0 +1,294 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gdul/execution/job_handler/job_timer_queue.h>
+#include <gdul/execution/job_handler/job/job_impl.h>
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace gdul {
+namespace jh_detail {
+namespace jtq_detail {
+// Index of the lowest set bit. Value must be non-zero
+inline std::uint8_t low_bit_index(std::uint64_t value) noexcept
+{
+#if defined(_MSC_VER)
+	unsigned long index(0);
+	_BitScanForward64(&index, value);
+	return (std::uint8_t)index;
+#else
+	return (std::uint8_t)__builtin_ctzll(value);
+#endif
+}
+inline std::uint64_t rotate_right(std::uint64_t value, std::uint8_t shift) noexcept
+{
+	return shift ? (value >> shift) | (value << (64 - shift)) : value;
+}
+constexpr std::chrono::nanoseconds TickDuration{ std::chrono::microseconds(TimerWheelTickUs) };
+}
+job_timer_queue::job_timer_queue(allocator_type alloc, delegate<void()>&& wakeWorker)
+	: m_wheel{}
+	, m_occupied{}
+	, m_currentTick(0)
+	, m_wheelCount(0)
+	, m_epoch(clock_type::now())
+	, m_wakeWorker(std::move(wakeWorker))
+	, m_allocator(alloc)
+	, m_intake(nullptr)
+	, m_nextDeadline(No_Deadline)
+	, m_pending(0)
+	, m_advancing()
+{
+	m_advancing.clear(std::memory_order_relaxed);
+}
+job_timer_queue::~job_timer_queue()
+{
+	destroy_list(m_intake.exchange(nullptr, std::memory_order_acquire));
+
+	for (auto& level : m_wheel) {
+		for (job_timer_node*& slot : level) {
+			destroy_list(slot);
+			slot = nullptr;
+		}
+	}
+}
+void job_timer_queue::push(job_impl_ptr jb, clock_type::time_point deadline)
+{
+	job_timer_node* const node(m_allocator.allocate(1));
+	new (node) job_timer_node{ std::move(jb), to_tick(deadline), nullptr };
+
+	m_pending.fetch_add(1, std::memory_order_relaxed);
+
+	job_timer_node* head(m_intake.load(std::memory_order_relaxed));
+	do {
+		node->m_next = head;
+	} while (!m_intake.compare_exchange_weak(head, node, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+	std::uint64_t next(m_nextDeadline.load(std::memory_order_relaxed));
+	while (node->m_deadline < next) {
+		if (m_nextDeadline.compare_exchange_weak(next, node->m_deadline, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+
+			// Parked workers may be waiting on a later deadline
+			m_wakeWorker();
+			break;
+		}
+	}
+}
+std::size_t job_timer_queue::advance()
+{
+	if (!m_pending.load(std::memory_order_relaxed)) {
+		return 0;
+	}
+
+	const std::uint64_t now(current_tick());
+
+	if (now < m_nextDeadline.load(std::memory_order_acquire)) {
+		return 0;
+	}
+	if (m_advancing.test_and_set(std::memory_order_acquire)) {
+		return 0;
+	}
+
+	job_timer_node* expired(nullptr);
+
+	job_timer_node* intake(m_intake.exchange(nullptr, std::memory_order_acquire));
+	while (intake) {
+		job_timer_node* const next(intake->m_next);
+		insert(intake, expired);
+		intake = next;
+	}
+
+	while (m_currentTick < now) {
+		const std::uint64_t nextEvent(next_event_tick());
+
+		if (now < nextEvent) {
+			m_currentTick = now;
+			break;
+		}
+
+		m_currentTick = nextEvent;
+
+		process_tick(expired);
+	}
+
+	m_nextDeadline.store(next_event_tick(), std::memory_order_seq_cst);
+
+	// A push may have come in after the intake was drained, but before the new deadline was published
+	if (m_intake.load(std::memory_order_seq_cst)) {
+		m_nextDeadline.store(0, std::memory_order_seq_cst);
+	}
+
+	m_advancing.clear(std::memory_order_release);
+
+	std::size_t released(0);
+
+	// Releasing outside of the wheel lets other workers advance while expired jobs are being submitted
+	while (expired) {
+		job_timer_node* const next(expired->m_next);
+
+		job_impl::release_dependant(std::move(expired->m_job));
+
+		expired->~job_timer_node();
+		m_allocator.deallocate(expired, 1);
+
+		expired = next;
+		++released;
+	}
+
+	m_pending.fetch_sub((std::uint32_t)released, std::memory_order_relaxed);
+
+	return released;
+}
+std::chrono::microseconds job_timer_queue::time_until_next() const noexcept
+{
+	const std::uint64_t next(m_nextDeadline.load(std::memory_order_relaxed));
+
+	if (next == No_Deadline) {
+		return std::chrono::microseconds::max();
+	}
+
+	const clock_type::time_point deadline(m_epoch + next * jtq_detail::TickDuration);
+	const clock_type::time_point now(clock_type::now());
+
+	if (!(now < deadline)) {
+		return std::chrono::microseconds(0);
+	}
+
+	return std::chrono::duration_cast<std::chrono::microseconds>(deadline - now) + std::chrono::microseconds(1);
+}
+std::uint32_t job_timer_queue::pending() const noexcept
+{
+	return m_pending.load(std::memory_order_relaxed);
+}
+std::uint64_t job_timer_queue::to_tick(clock_type::time_point tp) const noexcept
+{
+	if (!(m_epoch < tp)) {
+		return 0;
+	}
+
+	const std::uint64_t ns((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(tp - m_epoch).count());
+	const std::uint64_t tickNs((std::uint64_t)jtq_detail::TickDuration.count());
+
+	// Round up, so that no job is released before its deadline
+	return (ns + tickNs - 1) / tickNs;
+}
+std::uint64_t job_timer_queue::current_tick() const noexcept
+{
+	const std::uint64_t ns((std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_epoch).count());
+
+	return ns / (std::uint64_t)jtq_detail::TickDuration.count();
+}
+void job_timer_queue::insert(job_timer_node* node, job_timer_node*& expired)
+{
+	if (!(m_currentTick < node->m_deadline)) {
+		node->m_next = expired;
+		expired = node;
+		return;
+	}
+
+	const std::uint64_t delta(node->m_deadline - m_currentTick);
+
+	// Deadlines beyond the range of the wheel are parked in the outermost level and reinserted once cascaded
+	const std::uint64_t slotTick(delta < MaxDelta ? node->m_deadline : m_currentTick + MaxDelta - 1);
+	const std::uint64_t slotDelta(slotTick - m_currentTick);
+
+	std::uint8_t level(0);
+	while (!(slotDelta < (1ull << (LevelBits * (level + 1))))) {
+		++level;
+	}
+
+	const std::uint64_t slot((slotTick >> (LevelBits * level)) & SlotMask);
+
+	node->m_next = m_wheel[level][slot];
+	m_wheel[level][slot] = node;
+	m_occupied[level] |= 1ull << slot;
+
+	++m_wheelCount;
+}
+void job_timer_queue::cascade(std::uint8_t level, std::uint64_t slot, job_timer_node*& expired)
+{
+	job_timer_node* node(m_wheel[level][slot]);
+
+	m_wheel[level][slot] = nullptr;
+	m_occupied[level] &= ~(1ull << slot);
+
+	while (node) {
+		job_timer_node* const next(node->m_next);
+
+		--m_wheelCount;
+		insert(node, expired);
+
+		node = next;
+	}
+}
+void job_timer_queue::process_tick(job_timer_node*& expired)
+{
+	// Outer levels first, so that cascaded timers may be picked up by inner levels within the same tick
+	for (std::uint8_t level = Levels - 1; level != 0; --level) {
+		const std::uint8_t shift(LevelBits * level);
+
+		if (!(m_currentTick & ((1ull << shift) - 1))) {
+			cascade(level, (m_currentTick >> shift) & SlotMask, expired);
+		}
+	}
+
+	cascade(0, m_currentTick & SlotMask, expired);
+}
+std::uint64_t job_timer_queue::next_event_tick() const noexcept
+{
+	if (!m_wheelCount) {
+		return No_Deadline;
+	}
+
+	std::uint64_t result(No_Deadline);
+
+	for (std::uint8_t level = 0; level < Levels; ++level) {
+		if (!m_occupied[level]) {
+			continue;
+		}
+
+		const std::uint8_t shift(LevelBits * level);
+		const std::uint64_t levelTick(m_currentTick >> shift);
+		const std::uint64_t rotated(jtq_detail::rotate_right(m_occupied[level], (std::uint8_t)((levelTick + 1) & SlotMask)));
+		const std::uint64_t steps(jtq_detail::low_bit_index(rotated) + 1);
+
+		result = std::min(result, (levelTick + steps) << shift);
+	}
+
+	return result;
+}
+void job_timer_queue::destroy_list(job_timer_node* head)
+{
+	while (head) {
+		job_timer_node* const next(head->m_next);
+
+		head->~job_timer_node();
+		m_allocator.deallocate(head, 1);
+
+		head = next;
+	}
+}
+}
+}
@@ -0,0 +1,112 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#include <gdul/execution/job_handler/job_handler_utility.h>
+#include <gdul/execution/job_handler/globals.h>
+#include <gdul/execution/job_handler/job/job_impl_ptr.h>
+#include <gdul/utility/delegate.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace gdul {
+namespace jh_detail {
+
+class job_impl;
+
+struct job_timer_node
+{
+	job_impl_ptr m_job;
+	std::uint64_t m_deadline;
+	job_timer_node* m_next;
+};
+
+// Holds jobs until their deadlines pass, using a hierarchical timing wheel. Each held job owns one 
+// dependency, which is released once the deadline has passed, moving it to its target queue.
+// Timers may be pushed from any thread. The wheel is advanced by whichever worker gets there first,
+// all others return immediately
+class job_timer_queue
+{
+public:
+	using clock_type = std::chrono::steady_clock;
+
+	// wakeWorker is called as the next deadline moves up, so that a parked worker may pick it up
+	job_timer_queue(allocator_type alloc, delegate<void()>&& wakeWorker);
+	~job_timer_queue();
+
+	void push(job_impl_ptr jb, clock_type::time_point deadline);
+
+	// Releases jobs whose deadlines have passed. Returns the number of jobs released
+	std::size_t advance();
+
+	// Time until the wheel next needs advancing. Max if no timers are pending
+	std::chrono::microseconds time_until_next() const noexcept;
+
+	std::uint32_t pending() const noexcept;
+
+private:
+	static constexpr std::uint8_t LevelBits = 6;
+	static constexpr std::uint8_t Levels = 4;
+	static constexpr std::uint64_t Slots = 1ull << LevelBits;
+	static constexpr std::uint64_t SlotMask = Slots - 1;
+	static constexpr std::uint64_t MaxDelta = 1ull << (LevelBits * Levels);
+	static constexpr std::uint64_t No_Deadline = std::numeric_limits<std::uint64_t>::max();
+
+	using node_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<job_timer_node>;
+
+	std::uint64_t to_tick(clock_type::time_point tp) const noexcept;
+	std::uint64_t current_tick() const noexcept;
+
+	void insert(job_timer_node* node, job_timer_node*& expired);
+	void cascade(std::uint8_t level, std::uint64_t slot, job_timer_node*& expired);
+	void process_tick(job_timer_node*& expired);
+
+	std::uint64_t next_event_tick() const noexcept;
+
+	void destroy_list(job_timer_node* head);
+
+	// Only accessed by the advancing thread
+	std::array<std::array<job_timer_node*, Slots>, Levels> m_wheel;
+	std::array<std::uint64_t, Levels> m_occupied;
+	std::uint64_t m_currentTick;
+	std::uint32_t m_wheelCount;
+
+	const clock_type::time_point m_epoch;
+
+	delegate<void()> m_wakeWorker;
+	node_allocator_type m_allocator;
+
+	alignas(64) std::atomic<job_timer_node*> m_intake;
+	alignas(64) std::atomic<std::uint64_t> m_nextDeadline;
+	std::atomic<std::uint32_t> m_pending;
+	std::atomic_flag m_advancing;
+};
+}
+}
+#pragma warning(pop)
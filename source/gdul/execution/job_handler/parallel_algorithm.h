@@ -0,0 +1,120 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gdul/execution/job_handler/job_handler.h>
+
+#include <functional>
+#include <string_view>
+
+#undef parallel_sort
+#undef parallel_partition
+
+namespace gdul {
+
+namespace jh_detail {
+constexpr std::size_t Parallel_Sort_Id = constexp_str_hash(std::string_view("gdul::parallel_sort"));
+constexpr std::size_t Parallel_Partition_Id = constexp_str_hash(std::string_view("gdul::parallel_partition"));
+}
+
+/// <summary>
+/// Creates a batch job sorting container elements. Sorted slices are merged in parallel, while integral
+/// elements compared by std::less are radix sorted. Like other batch jobs, dependencies may be added before enable
+/// </summary>
+/// <typeparam name="Container">Container type. Requires size(), ::value_type, ::iterator and random access iterator. Elements must be default constructible and movable</typeparam>
+/// <typeparam name="Compare">Strict weak ordering, as with std::sort</typeparam>
+/// <param name="handler">Handler creating the job</param>
+/// <param name="container">Container to be sorted</param>
+/// <param name="compare">Comparison function object</param>
+/// <param name="target">Target queue</param>
+/// <param name="dbgName">Job debug name</param>
+/// <returns>New batch job</returns>
+template <class Container, class Compare>
+batch_job parallel_sort(job_handler& handler, Container& container, Compare compare, job_queue* target, const std::string_view& dbgName = "") { handler; container; compare; target; dbgName; /* See parallel_sort macro definition */ }
+
+/// <summary>
+/// Creates a batch job sorting container elements in ascending order, using std::less
+/// </summary>
+/// <typeparam name="Container">Container type. Requires size(), ::value_type, ::iterator and random access iterator. Elements must be default constructible and movable</typeparam>
+/// <param name="handler">Handler creating the job</param>
+/// <param name="container">Container to be sorted</param>
+/// <param name="target">Target queue</param>
+/// <param name="dbgName">Job debug name</param>
+/// <returns>New batch job</returns>
+template <class Container>
+batch_job parallel_sort(job_handler& handler, Container& container, job_queue* target, const std::string_view& dbgName = "") { handler; container; target; dbgName; /* See parallel_sort macro definition */ }
+
+/// <summary>
+/// Creates a batch job reordering container elements so that those satisfying predicate precede those that do not.
+/// Relative order is not preserved. The partition point is read using batch_job::get_result&lt;std::size_t&gt;() once finished
+/// </summary>
+/// <typeparam name="Container">Container type. Requires size(), ::value_type, ::iterator and random access iterator. Elements must be default constructible and movable</typeparam>
+/// <typeparam name="Predicate">Unary predicate, as with std::partition</typeparam>
+/// <param name="handler">Handler creating the job</param>
+/// <param name="container">Container to be partitioned</param>
+/// <param name="predicate">Predicate deciding which elements go first</param>
+/// <param name="target">Target queue</param>
+/// <param name="dbgName">Job debug name</param>
+/// <returns>New batch job</returns>
+template <class Container, class Predicate>
+batch_job parallel_partition(job_handler& handler, Container& container, Predicate predicate, job_queue* target, const std::string_view& dbgName = "") { handler; container; predicate; target; dbgName; /* See parallel_partition macro definition */ }
+
+// Not for direct use. See parallel_sort
+template <class Container, class Compare>
+batch_job _redirect_parallel_sort(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, job_handler& handler, Container& container, Compare compare, job_queue* target, const std::string_view& dbgName = "")
+{
+	return handler._redirect_make_sort_job(jh_detail::Parallel_Sort_Id + physicalId, dbgFile, line, container, std::move(compare), target, dbgName);
+}
+// Not for direct use. See parallel_sort
+template <class Container>
+batch_job _redirect_parallel_sort(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, job_handler& handler, Container& container, job_queue* target, const std::string_view& dbgName = "")
+{
+	return _redirect_parallel_sort(physicalId, dbgFile, line, handler, container, std::less<typename Container::value_type>(), target, dbgName);
+}
+// Not for direct use. See parallel_partition
+template <class Container, class Predicate>
+batch_job _redirect_parallel_partition(std::size_t physicalId, const std::string_view& dbgFile, std::uint32_t line, job_handler& handler, Container& container, Predicate predicate, job_queue* target, const std::string_view& dbgName = "")
+{
+	return handler._redirect_make_partition_job(jh_detail::Parallel_Partition_Id + physicalId, dbgFile, line, container, std::move(predicate), target, dbgName);
+}
+}
+
+// Signature 1:  gdul::batch_job (job_handler& handler, Container& container, Compare compare, job_queue* target, (opt) const std::string_view& dbgName)
+// Signature 2:  gdul::batch_job (job_handler& handler, Container& container, job_queue* target, (opt) const std::string_view& dbgName)
+#define parallel_sort(...) _redirect_parallel_sort( \
+GDUL_INLINE_PRAGMA(warning(push)) \
+GDUL_INLINE_PRAGMA(warning(disable : 4307)) \
+gdul::jh_detail::constexp_str_hash(__FILE__) \
+GDUL_INLINE_PRAGMA(warning(pop)) \
++ std::size_t(__LINE__) \
++ std::size_t(__COUNTER__) \
+, __FILE__, __LINE__, __VA_ARGS__)
+
+
+// Signature 1:  gdul::batch_job (job_handler& handler, Container& container, Predicate predicate, job_queue* target, (opt) const std::string_view& dbgName)
+#define parallel_partition(...) _redirect_parallel_partition( \
+GDUL_INLINE_PRAGMA(warning(push)) \
+GDUL_INLINE_PRAGMA(warning(disable : 4307)) \
+gdul::jh_detail::constexp_str_hash(__FILE__) \
+GDUL_INLINE_PRAGMA(warning(pop)) \
++ std::size_t(__LINE__) \
++ std::size_t(__COUNTER__) \
+, __FILE__, __LINE__, __VA_ARGS__)
@@ -0,0 +1,221 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace gdul {
+namespace jh_detail {
+
+// Index of the highest set bit. Value must be non-zero
+inline std::uint8_t high_bit_index(std::uint32_t value) noexcept
+{
+#if defined(_MSC_VER)
+	unsigned long index(0);
+	_BitScanReverse(&index, value);
+	return (std::uint8_t)index;
+#else
+	return (std::uint8_t)(31 - __builtin_clz(value));
+#endif
+}
+
+// Grow-only array with stable element addresses. Storage is a sequence of segments, each twice the
+// size of the one before, allocated the first time an index within them is claimed. Indexing never 
+// allocates and never locks
+template <class T, std::uint32_t FirstSegmentSize, class Allocator>
+class segmented_array
+{
+public:
+	using size_type = std::uint32_t;
+	using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+	segmented_array();
+	segmented_array(Allocator alloc);
+	~segmented_array();
+
+	segmented_array(const segmented_array&) = delete;
+	segmented_array& operator=(const segmented_array&) = delete;
+
+	// Makes sure the segment holding index exists. May be called concurrently
+	T& claim(size_type index);
+
+	// Index must previously have been claimed
+	T& operator[](size_type index) noexcept;
+	const T& operator[](size_type index) const noexcept;
+
+	// Returns nullptr if index has not yet been claimed by anyone
+	T* find(size_type index) noexcept;
+
+	// Not thread safe
+	void swap(segmented_array& other) noexcept;
+
+private:
+	static_assert(FirstSegmentSize && !(FirstSegmentSize & (FirstSegmentSize - 1)), "FirstSegmentSize must be a power of two");
+
+	static constexpr std::uint8_t to_bit(std::uint32_t pow2)
+	{
+		std::uint8_t bit(0);
+		for (; pow2 >> (bit + 1); ++bit);
+		return bit;
+	}
+
+	static constexpr std::uint8_t First_Segment_Bit = to_bit(FirstSegmentSize);
+	static constexpr std::uint8_t Max_Segments = 32 - First_Segment_Bit;
+
+	static std::uint8_t to_segment(size_type index) noexcept;
+	static size_type to_offset(size_type index, std::uint8_t segment) noexcept;
+	static size_type segment_size(std::uint8_t segment) noexcept;
+
+	std::array<std::atomic<T*>, Max_Segments> m_segments;
+
+	allocator_type m_allocator;
+};
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline segmented_array<T, FirstSegmentSize, Allocator>::segmented_array()
+	: segmented_array(Allocator())
+{
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline segmented_array<T, FirstSegmentSize, Allocator>::segmented_array(Allocator alloc)
+	: m_segments{}
+	, m_allocator(alloc)
+{
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline segmented_array<T, FirstSegmentSize, Allocator>::~segmented_array()
+{
+	for (std::uint8_t i = 0; i < Max_Segments; ++i) {
+		T* const segment(m_segments[i].load(std::memory_order_acquire));
+
+		if (!segment) {
+			continue;
+		}
+
+		const size_type size(segment_size(i));
+
+		for (size_type j = 0; j < size; ++j) {
+			std::allocator_traits<allocator_type>::destroy(m_allocator, &segment[j]);
+		}
+
+		m_allocator.deallocate(segment, size);
+	}
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline T& segmented_array<T, FirstSegmentSize, Allocator>::claim(size_type index)
+{
+	const std::uint8_t segmentIndex(to_segment(index));
+
+	T* segment(m_segments[segmentIndex].load(std::memory_order_acquire));
+
+	if (!segment) {
+		const size_type size(segment_size(segmentIndex));
+
+		T* const desired(m_allocator.allocate(size));
+
+		for (size_type i = 0; i < size; ++i) {
+			std::allocator_traits<allocator_type>::construct(m_allocator, &desired[i]);
+		}
+
+		if (m_segments[segmentIndex].compare_exchange_strong(segment, desired, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			segment = desired;
+		}
+		else {
+			for (size_type i = 0; i < size; ++i) {
+				std::allocator_traits<allocator_type>::destroy(m_allocator, &desired[i]);
+			}
+			m_allocator.deallocate(desired, size);
+		}
+	}
+
+	return segment[to_offset(index, segmentIndex)];
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline T& segmented_array<T, FirstSegmentSize, Allocator>::operator[](size_type index) noexcept
+{
+	const std::uint8_t segmentIndex(to_segment(index));
+
+	T* const segment(m_segments[segmentIndex].load(std::memory_order_acquire));
+
+	assert(segment && "Index has not been claimed");
+
+	return segment[to_offset(index, segmentIndex)];
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline const T& segmented_array<T, FirstSegmentSize, Allocator>::operator[](size_type index) const noexcept
+{
+	const std::uint8_t segmentIndex(to_segment(index));
+
+	const T* const segment(m_segments[segmentIndex].load(std::memory_order_acquire));
+
+	assert(segment && "Index has not been claimed");
+
+	return segment[to_offset(index, segmentIndex)];
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline T* segmented_array<T, FirstSegmentSize, Allocator>::find(size_type index) noexcept
+{
+	const std::uint8_t segmentIndex(to_segment(index));
+
+	if (T* const segment = m_segments[segmentIndex].load(std::memory_order_acquire)) {
+		return &segment[to_offset(index, segmentIndex)];
+	}
+
+	return nullptr;
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline void segmented_array<T, FirstSegmentSize, Allocator>::swap(segmented_array& other) noexcept
+{
+	for (std::uint8_t i = 0; i < Max_Segments; ++i) {
+		T* const mine(m_segments[i].load(std::memory_order_relaxed));
+		m_segments[i].store(other.m_segments[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		other.m_segments[i].store(mine, std::memory_order_relaxed);
+	}
+
+	std::swap(m_allocator, other.m_allocator);
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline std::uint8_t segmented_array<T, FirstSegmentSize, Allocator>::to_segment(size_type index) noexcept
+{
+	assert(index < (std::numeric_limits<size_type>::max() - FirstSegmentSize) && "Index out of range");
+
+	return high_bit_index(index + FirstSegmentSize) - First_Segment_Bit;
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline typename segmented_array<T, FirstSegmentSize, Allocator>::size_type segmented_array<T, FirstSegmentSize, Allocator>::to_offset(size_type index, std::uint8_t segment) noexcept
+{
+	return (index + FirstSegmentSize) - segment_size(segment);
+}
+template<class T, std::uint32_t FirstSegmentSize, class Allocator>
+inline typename segmented_array<T, FirstSegmentSize, Allocator>::size_type segmented_array<T, FirstSegmentSize, Allocator>::segment_size(std::uint8_t segment) noexcept
+{
+	return FirstSegmentSize << segment;
+}
+}
+}
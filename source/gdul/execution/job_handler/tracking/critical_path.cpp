@@ -0,0 +1,504 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <gdul/execution/job_handler/tracking/critical_path.h>
+#include <gdul/execution/job_handler/tracking/job_graph.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace gdul {
+namespace jh_detail {
+
+namespace cp_detail {
+
+struct instance
+{
+	std::uint64_t m_begin;
+	std::uint64_t m_end;
+	std::uint32_t m_node;
+	// Run from within another job on the same thread
+	bool m_nested;
+};
+
+struct open_instance
+{
+	std::uint64_t m_id;
+	std::uint64_t m_begin;
+};
+
+constexpr double NsToSeconds = 1e-9;
+
+// Longest path through nodes in topological (index) order along edges sorted by source. Fills in earliest starts 
+// and, optionally, the longest path from each node to the end of the frame (its own duration included)
+double longest_path(const std::vector<double>& durations, const std::vector<critical_path_edge>& edges, std::vector<double>& earliestStart, std::vector<double>* tail)
+{
+	earliestStart.assign(durations.size(), 0.0);
+
+	// Edges leading into a node all come from lower indices, whose earliest starts are settled by the time their edges come up
+	for (const critical_path_edge& edge : edges) {
+		earliestStart[edge.m_to] = std::max(earliestStart[edge.m_to], earliestStart[edge.m_from] + durations[edge.m_from]);
+	}
+
+	double length(0.0);
+	for (std::size_t i = 0; i < durations.size(); ++i) {
+		length = std::max(length, earliestStart[i] + durations[i]);
+	}
+
+	if (tail) {
+		tail->assign(durations.begin(), durations.end());
+
+		for (auto itr = edges.rbegin(); itr != edges.rend(); ++itr) {
+			(*tail)[itr->m_from] = std::max((*tail)[itr->m_from], durations[itr->m_from] + (*tail)[itr->m_to]);
+		}
+	}
+
+	return length;
+}
+
+bool nearly_equal(double a, double b, double length)
+{
+	return std::abs(a - b) <= length * 1e-9 + 1e-12;
+}
+
+void write_xml_string(std::ofstream& outStream, const std::string_view& str);
+void write_job_name(std::ofstream& outStream, std::uint64_t id, job_graph& graph);
+}
+}
+
+void critical_path::analyse(const std::vector<jh_detail::job_trace_event>& events, std::size_t frameCount, jh_detail::job_graph& graph)
+{
+	using namespace jh_detail;
+
+	m_frames.clear();
+	m_analysedUntil = 0;
+
+	if (events.empty() || !frameCount) {
+		return;
+	}
+
+	std::vector<std::uint64_t> marks;
+	std::uint64_t first(events.front().m_timestamp);
+	std::uint64_t last(events.front().m_timestamp);
+
+	for (const job_trace_event& ev : events) {
+		if (ev.m_type == job_trace_frame) {
+			marks.push_back(ev.m_timestamp);
+		}
+
+		first = std::min(first, ev.m_timestamp);
+		last = std::max(last, ev.m_timestamp);
+	}
+
+	if (marks.size() < 2) {
+		build_frame(events, first, last + 1, graph);
+		return;
+	}
+
+	std::sort(marks.begin(), marks.end());
+
+	const std::size_t complete(marks.size() - 1);
+	const std::size_t begin(complete < frameCount ? 0 : complete - frameCount);
+
+	for (std::size_t i = begin; i < complete; ++i) {
+		build_frame(events, marks[i], marks[i + 1], graph);
+	}
+
+	m_analysedUntil = marks[complete];
+}
+const std::vector<critical_path_frame>& critical_path::frames() const noexcept
+{
+	return m_frames;
+}
+std::uint64_t critical_path::analysed_until() const noexcept
+{
+	return m_analysedUntil;
+}
+std::vector<critical_path_bottleneck> critical_path::bottlenecks() const
+{
+	std::unordered_map<std::uint64_t, critical_path_bottleneck> accumulated;
+
+	for (const critical_path_frame& frame : m_frames) {
+		for (const critical_path_node& node : frame.m_nodes) {
+			if (!node.m_critical || !(0.0 < node.m_gain)) {
+				continue;
+			}
+
+			critical_path_bottleneck& entry(accumulated.try_emplace(node.m_id, critical_path_bottleneck{ node.m_id, 0.0, 0 }).first->second);
+			entry.m_gain += node.m_gain;
+			++entry.m_frames;
+		}
+	}
+
+	std::vector<critical_path_bottleneck> ranked;
+	ranked.reserve(accumulated.size());
+
+	for (auto& entry : accumulated) {
+		ranked.push_back(entry.second);
+	}
+
+	std::sort(ranked.begin(), ranked.end(), [](const critical_path_bottleneck& a, const critical_path_bottleneck& b) {
+		return b.m_gain < a.m_gain || (!(a.m_gain < b.m_gain) && a.m_id < b.m_id);
+		});
+
+	return ranked;
+}
+void critical_path::build_frame(const std::vector<jh_detail::job_trace_event>& events, std::uint64_t from, std::uint64_t to, jh_detail::job_graph& graph)
+{
+	using namespace jh_detail;
+	using namespace jh_detail::cp_detail;
+
+	critical_path_frame frame;
+	frame.m_begin = (double)from * NsToSeconds;
+	frame.m_length = (double)(to - from) * NsToSeconds;
+	frame.m_criticalLength = 0.0;
+	frame.m_parallelism.fill(0.0);
+
+	// Begin and end events are paired per thread. Begin events still waiting on their end event are left out
+	std::unordered_map<std::uint32_t, std::vector<open_instance>> open;
+	std::unordered_map<std::uint64_t, std::uint32_t> nodeIndices;
+	std::vector<instance> instances;
+
+	for (const job_trace_event& ev : events) {
+		if (ev.m_type == job_trace_begin) {
+			open[ev.m_thread].push_back(open_instance{ ev.m_id, ev.m_timestamp });
+			continue;
+		}
+		if (ev.m_type != job_trace_end) {
+			continue;
+		}
+
+		std::vector<open_instance>& stack(open[ev.m_thread]);
+
+		if (stack.empty()) {
+			continue;
+		}
+
+		const open_instance began(stack.back());
+		stack.pop_back();
+
+		if (began.m_begin < from || !(began.m_begin < to)) {
+			continue;
+		}
+
+		const auto itr(nodeIndices.try_emplace(began.m_id, (std::uint32_t)nodeIndices.size()).first);
+
+		instances.push_back(instance{ began.m_begin, std::max(ev.m_timestamp, began.m_begin), itr->second, !stack.empty() });
+	}
+
+	if (instances.empty()) {
+		m_frames.push_back(std::move(frame));
+		return;
+	}
+
+	std::sort(instances.begin(), instances.end(), [](const instance& a, const instance& b) {
+		return a.m_node < b.m_node || (a.m_node == b.m_node && a.m_begin < b.m_begin);
+		});
+
+	std::vector<critical_path_node> nodes(nodeIndices.size());
+
+	for (auto& entry : nodeIndices) {
+		nodes[entry.second].m_id = entry.first;
+	}
+
+	// Instances of a node are sorted by begin, so overlapping runs merge in one sweep
+	std::uint64_t coverEnd(0);
+	for (std::size_t i = 0; i < instances.size(); ++i) {
+		const instance& inst(instances[i]);
+		critical_path_node& node(nodes[inst.m_node]);
+
+		const double begin((double)(inst.m_begin - from) * NsToSeconds);
+		const double end((double)(inst.m_end - from) * NsToSeconds);
+
+		if (!node.m_instances) {
+			node.m_begin = begin;
+			node.m_end = end;
+			coverEnd = inst.m_begin;
+		}
+
+		const std::uint64_t coverFrom(std::max(coverEnd, inst.m_begin));
+		if (coverFrom < inst.m_end) {
+			node.m_duration += (double)(inst.m_end - coverFrom) * NsToSeconds;
+			coverEnd = inst.m_end;
+		}
+
+		node.m_end = std::max(node.m_end, end);
+		node.m_work += end - begin;
+		++node.m_instances;
+	}
+
+	// Index order becomes topological order. Dependants start after their dependencies finish, except where folding 
+	// instances together turns edges around
+	std::vector<std::uint32_t> order(nodes.size());
+	for (std::uint32_t i = 0; i < order.size(); ++i) {
+		order[i] = i;
+	}
+
+	std::sort(order.begin(), order.end(), [&nodes](std::uint32_t a, std::uint32_t b) {
+		return nodes[a].m_begin < nodes[b].m_begin || (!(nodes[b].m_begin < nodes[a].m_begin) && nodes[a].m_id < nodes[b].m_id);
+		});
+
+	std::vector<std::uint32_t> remap(nodes.size());
+	frame.m_nodes.reserve(nodes.size());
+
+	for (std::uint32_t i = 0; i < order.size(); ++i) {
+		remap[order[i]] = i;
+		frame.m_nodes.push_back(nodes[order[i]]);
+	}
+
+	for (auto& entry : nodeIndices) {
+		entry.second = remap[entry.second];
+	}
+
+	for (instance& inst : instances) {
+		inst.m_node = remap[inst.m_node];
+	}
+
+	for (const job_trace_event& ev : events) {
+		if (ev.m_type != job_trace_release || ev.m_timestamp < from || !(ev.m_timestamp < to)) {
+			continue;
+		}
+
+		const auto source(nodeIndices.find(ev.m_id));
+		const auto target(nodeIndices.find(ev.m_dependant));
+
+		if (source == nodeIndices.end() || target == nodeIndices.end() || !(source->second < target->second)) {
+			continue;
+		}
+
+		frame.m_edges.push_back(critical_path_edge{ source->second, target->second });
+	}
+
+	std::sort(frame.m_edges.begin(), frame.m_edges.end(), [](const critical_path_edge& a, const critical_path_edge& b) {
+		return a.m_from < b.m_from || (a.m_from == b.m_from && a.m_to < b.m_to);
+		});
+	frame.m_edges.erase(std::unique(frame.m_edges.begin(), frame.m_edges.end(), [](const critical_path_edge& a, const critical_path_edge& b) {
+		return a.m_from == b.m_from && a.m_to == b.m_to;
+		}), frame.m_edges.end());
+
+	std::vector<critical_path_node>& frameNodes(frame.m_nodes);
+	const std::vector<critical_path_edge>& edges(frame.m_edges);
+
+	std::vector<double> durations(frameNodes.size());
+	for (std::size_t i = 0; i < frameNodes.size(); ++i) {
+		durations[i] = frameNodes[i].m_duration;
+	}
+
+	std::vector<double> earliestStart;
+	std::vector<double> tail;
+
+	const double length(longest_path(durations, edges, earliestStart, &tail));
+	frame.m_criticalLength = length;
+
+	// Latest end among each node and everything depending on it
+	std::vector<double> latestEnd(frameNodes.size());
+	for (std::size_t i = 0; i < frameNodes.size(); ++i) {
+		latestEnd[i] = frameNodes[i].m_end;
+	}
+	for (auto itr = edges.rbegin(); itr != edges.rend(); ++itr) {
+		latestEnd[itr->m_from] = std::max(latestEnd[itr->m_from], latestEnd[itr->m_to]);
+	}
+
+	std::vector<double> scratch;
+
+	for (std::size_t i = 0; i < frameNodes.size(); ++i) {
+		critical_path_node& node(frameNodes[i]);
+
+		node.m_earliestStart = earliestStart[i];
+		node.m_latestStart = length - tail[i];
+		node.m_critical = nearly_equal(node.m_latestStart, node.m_earliestStart, length);
+		node.m_slack = node.m_critical ? 0.0 : node.m_latestStart - node.m_earliestStart;
+		node.m_remaining = latestEnd[i] - node.m_begin;
+
+		if (const job_info* const info = graph.fetch_job_info((std::size_t)node.m_id)) {
+			node.m_predictedRemaining = (double)info->get_runtime() + (double)info->get_dependant_runtime();
+		}
+
+		if (node.m_critical) {
+			const double duration(durations[i]);
+			durations[i] = 0.0;
+			node.m_gain = length - longest_path(durations, edges, scratch, nullptr);
+			durations[i] = duration;
+		}
+	}
+
+	// Walk the path from its first node, stepping to whichever critical dependant continues it
+	std::uint32_t at(0);
+	bool found(false);
+	for (std::uint32_t i = 0; i < frameNodes.size(); ++i) {
+		if (frameNodes[i].m_critical && nearly_equal(tail[i], length, length)) {
+			at = i;
+			found = true;
+			break;
+		}
+	}
+
+	while (found) {
+		frame.m_path.push_back(at);
+
+		const auto range(std::equal_range(edges.begin(), edges.end(), critical_path_edge{ at, 0 }, [](const critical_path_edge& a, const critical_path_edge& b) {
+			return a.m_from < b.m_from;
+			}));
+
+		found = false;
+		for (auto itr = range.first; itr != range.second; ++itr) {
+			if (frameNodes[itr->m_to].m_critical && nearly_equal(tail[at], durations[at] + tail[itr->m_to], length)) {
+				at = itr->m_to;
+				found = true;
+				break;
+			}
+		}
+	}
+
+	// Jobs run from within other jobs are already covered by the job they are run from
+	const double binLength(frame.m_length / (double)CriticalPathProfileBins);
+
+	for (const instance& inst : instances) {
+		if (inst.m_nested || !(0.0 < binLength)) {
+			continue;
+		}
+
+		const double begin((double)(inst.m_begin - from) * NsToSeconds);
+		const double end(std::min((double)(inst.m_end - from) * NsToSeconds, frame.m_length));
+
+		const std::size_t firstBin(std::min((std::size_t)(begin / binLength), (std::size_t)CriticalPathProfileBins - 1));
+
+		for (std::size_t bin = firstBin; bin < CriticalPathProfileBins; ++bin) {
+			const double binBegin((double)bin * binLength);
+			const double binEnd(binBegin + binLength);
+
+			if (!(binBegin < end)) {
+				break;
+			}
+
+			frame.m_parallelism[bin] += (std::min(end, binEnd) - std::max(begin, binBegin)) / binLength;
+		}
+	}
+
+	m_frames.push_back(std::move(frame));
+}
+bool critical_path::dump(const std::string_view& file, jh_detail::job_graph& graph) const
+{
+	using namespace jh_detail::cp_detail;
+
+	std::ofstream outStream;
+	outStream.open(std::string(file), std::ofstream::out);
+
+	if (!outStream.is_open()) {
+		return false;
+	}
+
+	outStream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+	outStream << "<critical_path frames=\"" << m_frames.size() << "\">\n";
+
+	const std::vector<critical_path_bottleneck> ranked(bottlenecks());
+
+	outStream << "<bottlenecks>\n";
+	for (std::size_t i = 0; i < ranked.size() && i < jh_detail::CriticalPathReportBottlenecks; ++i) {
+		outStream << "<job id=\"" << ranked[i].m_id << "\" name=\"";
+		write_job_name(outStream, ranked[i].m_id, graph);
+		outStream << "\" frames=\"" << ranked[i].m_frames << "\" gain=\"" << ranked[i].m_gain << "\" />\n";
+	}
+	outStream << "</bottlenecks>\n";
+
+	for (std::size_t i = 0; i < m_frames.size(); ++i) {
+		const critical_path_frame& frame(m_frames[i]);
+
+		outStream << "<frame index=\"" << i << "\" begin=\"" << frame.m_begin << "\" length=\"" << frame.m_length << "\" critical_length=\"" << frame.m_criticalLength << "\">\n";
+
+		outStream << "<parallelism>";
+		for (std::size_t bin = 0; bin < frame.m_parallelism.size(); ++bin) {
+			outStream << (bin ? " " : "") << frame.m_parallelism[bin];
+		}
+		outStream << "</parallelism>\n";
+
+		outStream << "<path>\n";
+		for (std::uint32_t index : frame.m_path) {
+			const critical_path_node& node(frame.m_nodes[index]);
+
+			outStream << "<job id=\"" << node.m_id << "\" name=\"";
+			write_job_name(outStream, node.m_id, graph);
+			outStream << "\" duration=\"" << node.m_duration << "\" gain=\"" << node.m_gain << "\" />\n";
+		}
+		outStream << "</path>\n";
+
+		outStream << "<jobs>\n";
+		for (const critical_path_node& node : frame.m_nodes) {
+			outStream << "<job id=\"" << node.m_id << "\" name=\"";
+			write_job_name(outStream, node.m_id, graph);
+			outStream << "\" critical=\"" << (node.m_critical ? "true" : "false") << "\"";
+			outStream << " begin=\"" << node.m_begin << "\" end=\"" << node.m_end << "\"";
+			outStream << " duration=\"" << node.m_duration << "\" work=\"" << node.m_work << "\" instances=\"" << node.m_instances << "\"";
+			outStream << " earliest_start=\"" << node.m_earliestStart << "\" latest_start=\"" << node.m_latestStart << "\" slack=\"" << node.m_slack << "\"";
+			outStream << " gain=\"" << node.m_gain << "\" remaining=\"" << node.m_remaining << "\" predicted_remaining=\"" << node.m_predictedRemaining << "\" />\n";
+		}
+		outStream << "</jobs>\n";
+
+		outStream << "<edges>\n";
+		for (const critical_path_edge& edge : frame.m_edges) {
+			outStream << "<edge from=\"" << frame.m_nodes[edge.m_from].m_id << "\" to=\"" << frame.m_nodes[edge.m_to].m_id << "\" />\n";
+		}
+		outStream << "</edges>\n";
+
+		outStream << "</frame>\n";
+	}
+
+	outStream << "</critical_path>\n";
+
+	outStream.close();
+
+	return true;
+}
+namespace jh_detail {
+namespace cp_detail {
+void write_xml_string(std::ofstream& outStream, const std::string_view& str)
+{
+	for (char c : str) {
+		switch (c) {
+		case '&': outStream << "&amp;"; break;
+		case '<': outStream << "&lt;"; break;
+		case '>': outStream << "&gt;"; break;
+		case '"': outStream << "&quot;"; break;
+		case '\'': outStream << "&apos;"; break;
+		default: outStream << c; break;
+		}
+	}
+}
+void write_job_name(std::ofstream& outStream, std::uint64_t id, [[maybe_unused]] job_graph& graph)
+{
+#if defined (GDUL_JOB_DEBUG)
+	if (const job_info* const info = graph.fetch_job_info((std::size_t)id)) {
+		if (!info->name().empty()) {
+			write_xml_string(outStream, info->name());
+			return;
+		}
+	}
+#endif
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "job %016llx", (unsigned long long)id);
+
+	write_xml_string(outStream, buffer);
+}
+}
+}
+}
@@ -0,0 +1,125 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <gdul/execution/job_handler/globals.h>
+#include <gdul/execution/job_handler/tracking/job_tracer.h>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace gdul {
+namespace jh_detail {
+class job_graph;
+}
+
+// A job's activity within one frame. Instances sharing a job id (such as the sub jobs of a batch, or a job made in 
+// a loop) are folded into one node
+struct critical_path_node
+{
+	std::uint64_t m_id;
+
+	// Seconds since frame start
+	double m_begin;
+	double m_end;
+
+	// Time covered by any running instance
+	double m_duration;
+	// Summed instance runtimes
+	double m_work;
+
+	double m_earliestStart;
+	double m_latestStart;
+	double m_slack;
+
+	// Frame critical path reduction should this node take no time
+	double m_gain;
+
+	// Measured time from node start until the last job depending on it finishes
+	double m_remaining;
+	// The same, as predicted by the job_info heuristics driving the sync queue priorities
+	double m_predictedRemaining;
+
+	std::uint32_t m_instances;
+	bool m_critical;
+};
+
+struct critical_path_edge
+{
+	std::uint32_t m_from;
+	std::uint32_t m_to;
+};
+
+struct critical_path_frame
+{
+	// Seconds since the tracer was created
+	double m_begin;
+	double m_length;
+
+	// Frame length were it limited by dependencies only
+	double m_criticalLength;
+
+	// Sorted by begin
+	std::vector<critical_path_node> m_nodes;
+	std::vector<critical_path_edge> m_edges;
+
+	// Node indices, in order
+	std::vector<std::uint32_t> m_path;
+
+	// Average number of jobs running over each slice of the frame
+	std::array<double, jh_detail::CriticalPathProfileBins> m_parallelism;
+};
+
+struct critical_path_bottleneck
+{
+	std::uint64_t m_id;
+	double m_gain;
+	std::uint32_t m_frames;
+};
+
+// Critical path analysis over traced frames. job_graph only holds aggregate per job timings, so frames are rebuilt from 
+// the begin, end and release events of job_tracer and split by its frame marks
+class critical_path
+{
+public:
+	// Analyses the last frameCount complete frames. With fewer than two frame marks recorded, the whole trace is one frame
+	void analyse(const std::vector<jh_detail::job_trace_event>& events, std::size_t frameCount, jh_detail::job_graph& graph);
+
+	const std::vector<critical_path_frame>& frames() const noexcept;
+
+	// Timestamp of the frame mark ending the last analysed frame. Earlier events are no longer needed by later 
+	// analyses. Zero if the trace was analysed as one frame
+	std::uint64_t analysed_until() const noexcept;
+
+	// Jobs ranked by the summed frame time won should they take no time
+	std::vector<critical_path_bottleneck> bottlenecks() const;
+
+	// Writes the analysis as xml
+	bool dump(const std::string_view& file, jh_detail::job_graph& graph) const;
+
+private:
+	void build_frame(const std::vector<jh_detail::job_trace_event>& events, std::uint64_t from, std::uint64_t to, jh_detail::job_graph& graph);
+
+	std::vector<critical_path_frame> m_frames;
+
+	std::uint64_t m_analysedUntil = 0;
+};
+}
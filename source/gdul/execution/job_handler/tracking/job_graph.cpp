@@ -266,6 +266,9 @@ void write_job_time_set(const time_set& timeSet, std::ofstream& toStream, const
 	toStream << "<max_time>" << timeSet.get_max() << "</max_time>\n";
 	toStream << "<min_timepoint>" << timeSet.get_minTimepoint() << "</min_timepoint>\n";
 	toStream << "<max_timepoint>" << timeSet.get_maxTimepoint() << "</max_timepoint>\n";
+	toStream << "<p50_time>" << timeSet.get_percentile(0.5f) << "</p50_time>\n";
+	toStream << "<p99_time>" << timeSet.get_percentile(0.99f) << "</p99_time>\n";
+	toStream << "<p999_time>" << timeSet.get_percentile(0.999f) << "</p999_time>\n";
 	toStream << "<completion_count>" << timeSet.get_completion_count() << "</completion_count>\n";
 	toStream << "</time_set>\n";
 }
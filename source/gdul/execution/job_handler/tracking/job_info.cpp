@@ -30,6 +30,7 @@ job_info::job_info()
 	, m_lastAccumulatedPropagationTime(0.f)
 	, m_propagationTime(0.f)
 	, m_runtime(0.f)
+	, m_elementCost(0.f)
 
 #if defined(GDUL_JOB_DEBUG)
 	, m_name()
@@ -70,6 +71,7 @@ job_info& job_info::operator=(const job_info& other)
 	m_propagationTime = other.m_propagationTime.load();
 
 	m_runtime = other.m_runtime;
+	m_elementCost = other.m_elementCost;
 
 #if defined(GDUL_JOB_DEBUG)
 	m_parent = other.m_parent;
@@ -139,6 +141,14 @@ float job_info::get_runtime() const
 {
 	return m_runtime;
 }
+float job_info::get_element_cost() const
+{
+	return m_elementCost;
+}
+void job_info::store_element_cost(float cost)
+{
+	m_elementCost = cost;
+}
 std::size_t job_info::id() const
 {
 	return m_id;
@@ -57,6 +57,10 @@ struct job_info
 	float get_runtime() const;
 	void store_runtime(float runtime);
 
+	// Average time spent processing one item of a batch job
+	float get_element_cost() const;
+	void store_element_cost(float cost);
+
 	std::size_t id() const;
 
 #if defined(GDUL_JOB_DEBUG)
@@ -87,6 +91,7 @@ private:
 	std::atomic<float> m_propagationTime;
 
 	float m_runtime;
+	float m_elementCost;
 
 #if defined(GDUL_JOB_DEBUG)
 	std::string m_name;
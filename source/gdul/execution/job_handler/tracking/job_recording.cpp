@@ -0,0 +1,335 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <gdul/execution/job_handler/tracking/job_recording.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace gdul {
+namespace jh_detail {
+
+constexpr char RecordingMagic[4]{ 'G', 'J', 'R', 'C' };
+constexpr std::uint32_t RecordingVersion = 1;
+
+// Serialized sizes, fields being written back to back
+constexpr std::uint64_t RecordingJobSize = sizeof(std::uint64_t) * 4 + sizeof(std::uint32_t) * 2;
+constexpr std::uint64_t RecordingEdgeSize = sizeof(std::uint32_t) * 2;
+
+struct recording_run
+{
+	job_recording_job m_job;
+	bool m_finished;
+};
+
+template <class T>
+void write_value(std::ofstream& outStream, const T& value)
+{
+	outStream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+template <class T>
+bool read_value(std::ifstream& inStream, T& value)
+{
+	return (bool)inStream.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+}
+
+void job_recording::build(const std::vector<jh_detail::job_trace_event>& events)
+{
+	using namespace jh_detail;
+
+	m_jobs.clear();
+	m_edges.clear();
+
+	if (events.empty()) {
+		return;
+	}
+
+	// Events are collected ring by ring. A stable sort keeps each thread's events in the order they were recorded
+	std::vector<job_trace_event> sorted(events);
+	std::stable_sort(sorted.begin(), sorted.end(), [](const job_trace_event& a, const job_trace_event& b) {
+		return a.m_timestamp < b.m_timestamp;
+		});
+
+	const std::uint64_t origin(sorted.front().m_timestamp);
+
+	std::vector<recording_run> runs;
+	std::vector<job_recording_edge> edges;
+
+	// Runs seen enqueued or released, but not yet begun. A job address may be reused once its run is done
+	std::unordered_map<std::uint64_t, std::uint32_t> waiting;
+	// Latest run begun by each job address
+	std::unordered_map<std::uint64_t, std::uint32_t> latest;
+	std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> running;
+
+	auto waiting_run = [&runs, &waiting](std::uint64_t instance, std::uint64_t id, std::uint64_t timestamp) {
+		const auto itr(waiting.try_emplace(instance, (std::uint32_t)runs.size()));
+
+		if (itr.second) {
+			recording_run run{};
+			run.m_job.id = id;
+			run.m_job.ready = timestamp;
+			runs.push_back(run);
+		}
+
+		return itr.first->second;
+	};
+
+	for (const job_trace_event& ev : sorted) {
+		const std::uint64_t timestamp(ev.m_timestamp - origin);
+
+		switch (ev.m_type) {
+		case job_trace_enqueue:
+			waiting_run(ev.m_instance, ev.m_id, timestamp);
+			break;
+		case job_trace_release:
+		{
+			std::uint32_t source(0);
+			bool known(false);
+
+			// A job releasing dependants without having begun was cancelled and skipped
+			if (const auto skipped = waiting.find(ev.m_instance); skipped != waiting.end()) {
+				source = skipped->second;
+				known = true;
+
+				recording_run& run(runs[source]);
+				run.m_job.begin = timestamp;
+				run.m_job.thread = ev.m_thread;
+				run.m_job.flags |= job_recording_flag_skipped;
+				run.m_finished = true;
+
+				waiting.erase(skipped);
+				latest[ev.m_instance] = source;
+			}
+			else if (const auto ran = latest.find(ev.m_instance); ran != latest.end()) {
+				source = ran->second;
+				known = true;
+			}
+
+			const std::uint32_t dependant(waiting_run(ev.m_dependantInstance, ev.m_dependant, timestamp));
+
+			// Dependants of jobs run before recording started are treated as having been enqueued from outside
+			if (known) {
+				edges.push_back(job_recording_edge{ source, dependant });
+			}
+			break;
+		}
+		case job_trace_begin:
+		{
+			const std::uint32_t index(waiting_run(ev.m_instance, ev.m_id, timestamp));
+			std::vector<std::uint32_t>& stack(running[ev.m_thread]);
+
+			recording_run& run(runs[index]);
+			run.m_job.begin = timestamp;
+			run.m_job.thread = ev.m_thread;
+			run.m_job.flags |= stack.empty() ? job_recording_flag_none : job_recording_flag_nested;
+
+			stack.push_back(index);
+			waiting.erase(ev.m_instance);
+			latest[ev.m_instance] = index;
+			break;
+		}
+		case job_trace_end:
+		{
+			std::vector<std::uint32_t>& stack(running[ev.m_thread]);
+
+			if (stack.empty()) {
+				break;
+			}
+
+			recording_run& run(runs[stack.back()]);
+			run.m_job.runtime = timestamp - std::min(timestamp, run.m_job.begin);
+			run.m_finished = true;
+
+			stack.pop_back();
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	std::vector<std::uint32_t> order;
+	for (std::uint32_t i = 0; i < runs.size(); ++i) {
+		if (runs[i].m_finished) {
+			order.push_back(i);
+		}
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&runs](std::uint32_t a, std::uint32_t b) {
+		return runs[a].m_job.begin < runs[b].m_job.begin;
+		});
+
+	constexpr std::uint32_t Unmapped(~0u);
+	std::vector<std::uint32_t> remap(runs.size(), Unmapped);
+
+	m_jobs.reserve(order.size());
+
+	for (std::uint32_t i = 0; i < order.size(); ++i) {
+		remap[order[i]] = i;
+		m_jobs.push_back(runs[order[i]].m_job);
+	}
+
+	for (const job_recording_edge& edge : edges) {
+		const std::uint32_t from(remap[edge.from]);
+		const std::uint32_t to(remap[edge.to]);
+
+		if (from != Unmapped && to != Unmapped && from < to) {
+			m_edges.push_back(job_recording_edge{ from, to });
+		}
+	}
+
+	std::sort(m_edges.begin(), m_edges.end(), [](const job_recording_edge& a, const job_recording_edge& b) {
+		return a.from < b.from || (a.from == b.from && a.to < b.to);
+		});
+	m_edges.erase(std::unique(m_edges.begin(), m_edges.end(), [](const job_recording_edge& a, const job_recording_edge& b) {
+		return a.from == b.from && a.to == b.to;
+		}), m_edges.end());
+}
+bool job_recording::save(const std::string_view& file) const
+{
+	using namespace jh_detail;
+
+	std::ofstream outStream;
+	outStream.open(std::string(file), std::ofstream::out | std::ofstream::binary);
+
+	if (!outStream.is_open()) {
+		return false;
+	}
+
+	outStream.write(RecordingMagic, sizeof(RecordingMagic));
+	write_value(outStream, RecordingVersion);
+	write_value(outStream, (std::uint32_t)m_jobs.size());
+	write_value(outStream, (std::uint32_t)m_edges.size());
+
+	for (const job_recording_job& jb : m_jobs) {
+		write_value(outStream, jb.id);
+		write_value(outStream, jb.ready);
+		write_value(outStream, jb.begin);
+		write_value(outStream, jb.runtime);
+		write_value(outStream, jb.thread);
+		write_value(outStream, jb.flags);
+	}
+	for (const job_recording_edge& edge : m_edges) {
+		write_value(outStream, edge.from);
+		write_value(outStream, edge.to);
+	}
+
+	outStream.close();
+
+	return true;
+}
+bool job_recording::load(const std::string_view& file)
+{
+	using namespace jh_detail;
+
+	m_jobs.clear();
+	m_edges.clear();
+
+	std::ifstream inStream;
+	inStream.open(std::string(file), std::ifstream::in | std::ifstream::binary);
+
+	if (!inStream.is_open()) {
+		return false;
+	}
+
+	char magic[sizeof(RecordingMagic)]{};
+	std::uint32_t version(0);
+	std::uint32_t jobCount(0);
+	std::uint32_t edgeCount(0);
+
+	if (!inStream.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), RecordingMagic)) {
+		return false;
+	}
+	if (!read_value(inStream, version) || version != RecordingVersion) {
+		return false;
+	}
+	if (!read_value(inStream, jobCount) || !read_value(inStream, edgeCount)) {
+		return false;
+	}
+
+	// Counts are checked against the file size before anything is allocated for them
+	const std::ifstream::pos_type payloadBegin(inStream.tellg());
+	if (!inStream.seekg(0, std::ifstream::end)) {
+		return false;
+	}
+	const std::uint64_t payloadSize((std::uint64_t)(inStream.tellg() - payloadBegin));
+	if (payloadSize != jobCount * RecordingJobSize + edgeCount * RecordingEdgeSize || !inStream.seekg(payloadBegin)) {
+		return false;
+	}
+
+	m_jobs.resize(jobCount);
+	m_edges.resize(edgeCount);
+
+	bool ok(true);
+
+	for (job_recording_job& jb : m_jobs) {
+		ok &= read_value(inStream, jb.id);
+		ok &= read_value(inStream, jb.ready);
+		ok &= read_value(inStream, jb.begin);
+		ok &= read_value(inStream, jb.runtime);
+		ok &= read_value(inStream, jb.thread);
+		ok &= read_value(inStream, jb.flags);
+	}
+	std::uint32_t lastFrom(0);
+
+	for (job_recording_edge& edge : m_edges) {
+		ok &= read_value(inStream, edge.from);
+		ok &= read_value(inStream, edge.to);
+
+		// job_simulator relies on edges being sorted by source
+		ok &= lastFrom <= edge.from && edge.from < edge.to && edge.to < jobCount;
+
+		lastFrom = edge.from;
+	}
+
+	if (!ok) {
+		m_jobs.clear();
+		m_edges.clear();
+	}
+
+	return ok;
+}
+const std::vector<job_recording_job>& job_recording::jobs() const noexcept
+{
+	return m_jobs;
+}
+const std::vector<job_recording_edge>& job_recording::edges() const noexcept
+{
+	return m_edges;
+}
+double job_recording::makespan() const noexcept
+{
+	if (m_jobs.empty()) {
+		return 0.0;
+	}
+
+	std::uint64_t first(m_jobs.front().ready);
+	std::uint64_t last(0);
+
+	for (const job_recording_job& jb : m_jobs) {
+		first = std::min(first, jb.ready);
+		last = std::max(last, jb.begin + jb.runtime);
+	}
+
+	return (double)(last - std::min(first, last)) * 1e-9;
+}
+}
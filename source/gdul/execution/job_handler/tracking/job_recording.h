@@ -0,0 +1,99 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <gdul/execution/job_handler/tracking/job_tracer.h>
+
+#include <string_view>
+#include <vector>
+
+namespace gdul {
+
+enum job_recording_flag : std::uint32_t
+{
+	job_recording_flag_none = 0,
+	// Run from within another job on the same thread, whose runtime already covers it
+	job_recording_flag_nested = 1 << 0,
+	// Finished without running, having been cancelled
+	job_recording_flag_skipped = 1 << 1,
+};
+
+// One run of a job. Times are in nanoseconds since the first recorded event
+struct job_recording_job
+{
+	std::uint64_t id;
+	// Time the job was enqueued, or if it was released by a recorded job, the time it was released
+	std::uint64_t ready;
+	std::uint64_t begin;
+	std::uint64_t runtime;
+	std::uint32_t thread;
+	std::uint32_t flags;
+};
+
+// A finishing job releasing a dependant. Indices into job_recording::jobs
+struct job_recording_edge
+{
+	std::uint32_t from;
+	std::uint32_t to;
+};
+
+/// <summary>
+/// Jobs and dependency edges of a traced run, stored as a compact binary file which may be loaded without a job_handler, 
+/// for instance to be replayed by job_simulator on another machine
+/// </summary>
+class job_recording
+{
+public:
+	/// <summary>
+	/// Rebuild job runs from trace events. Runs that had not finished as the events were collected are left out
+	/// </summary>
+	/// <param name="events">Collected trace events</param>
+	void build(const std::vector<jh_detail::job_trace_event>& events);
+
+	/// <summary>
+	/// Write to file. Values are stored in native byte order (little endian on all supported platforms)
+	/// </summary>
+	/// <param name="file">Output file path</param>
+	/// <returns>False if the file could not be opened</returns>
+	bool save(const std::string_view& file) const;
+
+	/// <summary>
+	/// Read from file
+	/// </summary>
+	/// <param name="file">Input file path</param>
+	/// <returns>False if the file could not be opened or was not a recording</returns>
+	bool load(const std::string_view& file);
+
+	/// <summary>
+	/// Recorded job runs, ordered by begin time. Edges always lead from lower to higher indices
+	/// </summary>
+	const std::vector<job_recording_job>& jobs() const noexcept;
+	const std::vector<job_recording_edge>& edges() const noexcept;
+
+	/// <summary>
+	/// Time from the first job becoming ready until the last job finished, in seconds
+	/// </summary>
+	double makespan() const noexcept;
+
+private:
+	std::vector<job_recording_job> m_jobs;
+	std::vector<job_recording_edge> m_edges;
+};
+}
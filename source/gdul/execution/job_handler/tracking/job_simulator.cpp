@@ -0,0 +1,226 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <gdul/execution/job_handler/tracking/job_simulator.h>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace gdul {
+namespace jh_detail {
+
+std::uint64_t simulated_runtime(const job_recording_job& jb) noexcept
+{
+	return (jb.flags & job_recording_flag_nested) ? 0 : jb.runtime;
+}
+}
+
+job_simulator::job_simulator(job_recording recording)
+	: m_recording(std::move(recording))
+	, m_edgeOffsets(m_recording.jobs().size() + 1, 0)
+	, m_dependencies(m_recording.jobs().size(), 0)
+	, m_remaining(m_recording.jobs().size(), 0)
+{
+	const std::vector<job_recording_job>& jobs(m_recording.jobs());
+	const std::vector<job_recording_edge>& edges(m_recording.edges());
+
+	// Edges are sorted by source
+	for (const job_recording_edge& edge : edges) {
+		++m_edgeOffsets[edge.from + 1];
+		++m_dependencies[edge.to];
+	}
+	for (std::size_t i = 0; i < jobs.size(); ++i) {
+		m_edgeOffsets[i + 1] += m_edgeOffsets[i];
+	}
+
+	// Edges lead to higher indices, so dependants are settled first when walking backwards
+	for (std::size_t i = jobs.size(); i-- > 0;) {
+		std::uint64_t longest(0);
+
+		for (std::uint32_t e = m_edgeOffsets[i]; e < m_edgeOffsets[i + 1]; ++e) {
+			longest = std::max(longest, m_remaining[edges[e].to]);
+		}
+
+		m_remaining[i] = jh_detail::simulated_runtime(jobs[i]) + longest;
+	}
+}
+job_simulation_result job_simulator::run(std::uint32_t workers, job_simulation_policy policy) const
+{
+	const std::vector<job_recording_job>& jobs(m_recording.jobs());
+	const std::vector<job_recording_edge>& edges(m_recording.edges());
+
+	job_simulation_result result{};
+
+	if (jobs.empty() || !workers) {
+		return result;
+	}
+
+	constexpr std::uint32_t NoWorker(~0u);
+
+	std::vector<std::uint32_t> unresolved(m_dependencies);
+
+	std::vector<std::uint32_t> arrivals;
+	for (std::uint32_t i = 0; i < jobs.size(); ++i) {
+		if (!unresolved[i]) {
+			arrivals.push_back(i);
+		}
+	}
+	std::stable_sort(arrivals.begin(), arrivals.end(), [&jobs](std::uint32_t a, std::uint32_t b) {
+		return jobs[a].ready < jobs[b].ready;
+		});
+
+	// Shared FIFO for the async policy, and the injector queue when work stealing
+	std::deque<std::uint32_t> shared;
+	// Highest remaining time first, earlier recorded jobs breaking ties
+	std::priority_queue<std::pair<std::uint64_t, std::uint32_t>> prioritized;
+	std::vector<std::deque<std::uint32_t>> deques(policy == job_simulation_work_stealing ? workers : 0);
+
+	auto push = [&](std::uint32_t jb, std::uint32_t from) {
+		switch (policy) {
+		case job_simulation_sync_priority:
+			prioritized.push(std::make_pair(m_remaining[jb], ~jb));
+			break;
+		case job_simulation_work_stealing:
+			if (from != NoWorker) {
+				deques[from].push_back(jb);
+				break;
+			}
+			shared.push_back(jb);
+			break;
+		default:
+			shared.push_back(jb);
+			break;
+		}
+	};
+
+	auto pop = [&](std::uint32_t worker, bool steal, std::uint32_t& out) {
+		if (policy == job_simulation_sync_priority) {
+			if (prioritized.empty()) {
+				return false;
+			}
+			out = ~prioritized.top().second;
+			prioritized.pop();
+			return true;
+		}
+		if (policy == job_simulation_work_stealing) {
+			if (!deques[worker].empty()) {
+				out = deques[worker].back();
+				deques[worker].pop_back();
+				return true;
+			}
+		}
+		if (!shared.empty()) {
+			out = shared.front();
+			shared.pop_front();
+			return true;
+		}
+		if (steal) {
+			for (std::uint32_t i = 1; i < workers; ++i) {
+				std::deque<std::uint32_t>& victim(deques[(worker + i) % workers]);
+
+				if (!victim.empty()) {
+					out = victim.front();
+					victim.pop_front();
+					++result.steals;
+					return true;
+				}
+			}
+		}
+		return false;
+	};
+
+	std::vector<std::uint32_t> current(workers, 0);
+	std::vector<bool> busy(workers, false);
+
+	using finish_event = std::pair<std::uint64_t, std::uint32_t>;
+	std::priority_queue<finish_event, std::vector<finish_event>, std::greater<finish_event>> finishes;
+
+	const std::uint64_t start(jobs[arrivals.front()].ready);
+	std::uint64_t time(start);
+	std::uint64_t end(start);
+	std::uint64_t busyTime(0);
+
+	std::size_t arrived(0);
+
+	for (;;) {
+		while (arrived < arrivals.size() && !(time < jobs[arrivals[arrived]].ready)) {
+			push(arrivals[arrived++], NoWorker);
+		}
+
+		// Workers drain their own deques before any of them turn to stealing
+		for (std::uint8_t pass = 0; pass < 2; ++pass) {
+			for (std::uint32_t worker = 0; worker < workers; ++worker) {
+				std::uint32_t jb(0);
+
+				if (busy[worker] || !pop(worker, pass == 1 && policy == job_simulation_work_stealing, jb)) {
+					continue;
+				}
+
+				const std::uint64_t runtime(jh_detail::simulated_runtime(jobs[jb]));
+
+				busy[worker] = true;
+				current[worker] = jb;
+				busyTime += runtime;
+
+				finishes.push(std::make_pair(time + runtime, worker));
+			}
+		}
+
+		if (finishes.empty()) {
+			if (arrived == arrivals.size()) {
+				break;
+			}
+
+			time = jobs[arrivals[arrived]].ready;
+			continue;
+		}
+
+		time = finishes.top().first;
+
+		if (arrived < arrivals.size()) {
+			time = std::min(time, jobs[arrivals[arrived]].ready);
+		}
+
+		while (!finishes.empty() && finishes.top().first == time) {
+			const std::uint32_t worker(finishes.top().second);
+			finishes.pop();
+
+			busy[worker] = false;
+			end = std::max(end, time);
+
+			const std::uint32_t jb(current[worker]);
+
+			for (std::uint32_t e = m_edgeOffsets[jb]; e < m_edgeOffsets[jb + 1]; ++e) {
+				if (!--unresolved[edges[e].to]) {
+					push(edges[e].to, worker);
+				}
+			}
+		}
+	}
+
+	result.makespan = (double)(end - start) * 1e-9;
+	result.busyTime = (double)busyTime * 1e-9;
+	result.utilization = 0.0 < result.makespan ? result.busyTime / (result.makespan * (double)workers) : 0.0;
+
+	return result;
+}
+}
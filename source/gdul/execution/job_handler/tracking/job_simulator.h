@@ -0,0 +1,80 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <gdul/execution/job_handler/tracking/job_recording.h>
+
+namespace gdul {
+
+enum job_simulation_policy : std::uint8_t
+{
+	// Shared FIFO queue, as job_async_queue
+	job_simulation_async,
+	// Shared queue ordered by remaining dependant time, as job_sync_queue. Priorities are taken from the recording 
+	// rather than predicted
+	job_simulation_sync_priority,
+	// Per worker LIFO deques with FIFO stealing and a shared injector queue for outside submissions, as job_work_stealing_queue
+	job_simulation_work_stealing,
+};
+
+struct job_simulation_result
+{
+	// Time from the first job becoming ready until the last job finished, in seconds
+	double makespan;
+	// Summed job runtimes, in seconds
+	double busyTime;
+	// busyTime over makespan times worker count
+	double utilization;
+	// Jobs taken from another worker's deque
+	std::uint64_t steals;
+};
+
+/// <summary>
+/// Deterministic replay of a job_recording. Jobs keep their recorded runtimes and dependencies, while being scheduled 
+/// over a virtual set of workers using the chosen queue policy. Jobs with no recorded dependencies become ready at their 
+/// recorded ready time. Nested jobs take no time, being covered by the job they were run from
+/// </summary>
+class job_simulator
+{
+public:
+	/// <summary>
+	/// Constructor. The recording is copied, and may be discarded afterwards
+	/// </summary>
+	job_simulator(job_recording recording);
+
+	/// <summary>
+	/// Replay the recording. Repeated runs with the same arguments give the same result
+	/// </summary>
+	/// <param name="workers">Virtual worker count</param>
+	/// <param name="policy">Queue policy shared by all jobs</param>
+	/// <returns>Predicted timings</returns>
+	job_simulation_result run(std::uint32_t workers, job_simulation_policy policy) const;
+
+private:
+	const job_recording m_recording;
+
+	// Edges starting at each job, as offsets into the recording's edges
+	std::vector<std::uint32_t> m_edgeOffsets;
+	std::vector<std::uint32_t> m_dependencies;
+
+	// Longest runtime path from each job until the end of the recording, its own runtime included
+	std::vector<std::uint64_t> m_remaining;
+};
+}
@@ -0,0 +1,350 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gdul/execution/job_handler/tracking/job_tracer.h>
+#include <gdul/execution/job_handler/tracking/job_graph.h>
+#include <gdul/execution/job_handler/job/job_impl.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace gdul {
+namespace jh_detail {
+
+static std::atomic<std::uint64_t> s_tracerIds(1);
+
+thread_local job_trace_cache job_tracer::t_cache{};
+
+void write_json_string(std::ofstream& outStream, const std::string_view& str);
+void write_job_name(std::ofstream& outStream, std::uint64_t id, job_graph& graph);
+
+job_trace_ring::job_trace_ring(std::uint32_t index, std::thread::id owner)
+	: m_events()
+	, m_head(0)
+	, m_dropped(0)
+	, m_droppedBegins(0)
+	, m_depth(0)
+	, m_reservedEnds(0)
+	, m_tail(0)
+	, m_owner(owner)
+	, m_index(index)
+{
+}
+void job_trace_ring::push(const job_trace_event& ev) noexcept
+{
+	const std::uint32_t head(m_head.load(std::memory_order_relaxed));
+	const std::uint32_t free(JobTraceRingSize - (head - m_tail.load(std::memory_order_acquire)));
+
+	// Begin events deeper than the mask are assumed recorded
+	const std::uint64_t depthBit(m_depth < 64 ? 1ull << m_depth : 0);
+
+	bool drop(false);
+
+	switch (ev.m_type) {
+	case job_trace_enqueue:
+	case job_trace_release:
+	case job_trace_frame:
+		drop = !(m_reservedEnds < free);
+		break;
+	case job_trace_begin:
+		drop = !(m_reservedEnds + 1 < free);
+		m_droppedBegins = drop ? (m_droppedBegins | depthBit) : (m_droppedBegins & ~depthBit);
+		m_reservedEnds += !drop;
+		++m_depth;
+		break;
+	case job_trace_end:
+		assert(m_depth && "Unmatched job trace end event");
+		--m_depth;
+		if (m_depth < 64 && (m_droppedBegins & (1ull << m_depth))) {
+			// Counted along with its begin event
+			return;
+		}
+		--m_reservedEnds;
+		break;
+	}
+
+	if (drop) {
+		// Only ever written to by the owning thread
+		m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return;
+	}
+
+	m_events[head & (JobTraceRingSize - 1)] = ev;
+
+	m_head.store(head + 1, std::memory_order_release);
+}
+std::uint64_t job_trace_ring::dropped() const noexcept
+{
+	return m_dropped.load(std::memory_order_relaxed);
+}
+std::uint32_t job_trace_ring::size() const noexcept
+{
+	return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire);
+}
+std::uint32_t job_trace_ring::index() const noexcept
+{
+	return m_index;
+}
+std::thread::id job_trace_ring::owner() const noexcept
+{
+	return m_owner;
+}
+job_tracer::job_tracer(allocator_type alloc)
+	: m_epoch(std::chrono::steady_clock::now())
+	, m_lock()
+	, m_rings(alloc)
+	, m_collected(alloc)
+	, m_allocator(alloc)
+	, m_id(s_tracerIds.fetch_add(1, std::memory_order_relaxed))
+	, m_enabled(false)
+{
+}
+job_tracer::~job_tracer()
+{
+	ring_allocator_type alloc(m_allocator);
+
+	for (job_trace_ring* ring : m_rings) {
+		ring->~job_trace_ring();
+		alloc.deallocate(ring, 1);
+	}
+}
+void job_tracer::set_enabled(bool enabled) noexcept
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+bool job_tracer::is_enabled() const noexcept
+{
+	return m_enabled.load(std::memory_order_relaxed);
+}
+void job_tracer::record(job_trace_event_type type, const job_impl* jb, const job_impl* dependant)
+{
+	job_trace_ring& ring(this_ring());
+
+	job_trace_event ev;
+	ev.m_timestamp = now();
+	ev.m_id = jb ? jb->get_id() : 0;
+	ev.m_instance = (std::uint64_t)(std::uintptr_t)jb;
+	ev.m_dependant = dependant ? dependant->get_id() : 0;
+	ev.m_dependantInstance = (std::uint64_t)(std::uintptr_t)dependant;
+	ev.m_thread = ring.index();
+	ev.m_type = type;
+
+	ring.push(ev);
+
+	if (JobTraceRingSize / 2 < ring.size()) {
+		try_drain(ring);
+	}
+}
+void job_tracer::collect()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (job_trace_ring* ring : m_rings) {
+		ring->drain(m_collected);
+	}
+}
+void job_tracer::copy_collected(std::vector<job_trace_event>& out)
+{
+	collect();
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	out.assign(m_collected.begin(), m_collected.end());
+}
+void job_tracer::discard_collected(std::uint64_t until)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	m_collected.erase(std::remove_if(m_collected.begin(), m_collected.end(), [until](const job_trace_event& ev) { return ev.m_timestamp < until; }), m_collected.end());
+}
+bool job_tracer::dump_chrome_trace(const std::string_view& file, job_graph& graph)
+{
+	collect();
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	std::ofstream outStream;
+	outStream.open(std::string(file), std::ofstream::out);
+
+	if (!outStream.is_open()) {
+		return false;
+	}
+
+	std::uint64_t dropped(0);
+	for (job_trace_ring* ring : m_rings) {
+		dropped += ring->dropped();
+	}
+
+	outStream << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":" << dropped << "},\"traceEvents\":[";
+
+	// Written ahead of each entry, so that the last one goes without a trailing comma
+	const char* separator("\n");
+
+	for (job_trace_ring* ring : m_rings) {
+		outStream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << ring->index() << ",\"args\":{\"name\":\"Thread#" << ring->index() << "\"}}";
+		separator = ",\n";
+	}
+
+	char timestamp[32];
+
+	for (const job_trace_event& ev : m_collected) {
+		// Chrome trace timestamps are in microseconds
+		std::snprintf(timestamp, sizeof(timestamp), "%.3f", (double)ev.m_timestamp / 1000.0);
+
+		outStream << separator;
+		separator = ",\n";
+
+		if (ev.m_type == job_trace_frame) {
+			outStream << "{\"name\":\"frame\",\"cat\":\"frame\",\"pid\":0,\"tid\":" << ev.m_thread << ",\"ts\":" << timestamp << ",\"ph\":\"i\",\"s\":\"g\"}";
+			continue;
+		}
+
+		const char* const category(ev.m_type == job_trace_enqueue ? "enqueue" : (ev.m_type == job_trace_release ? "release" : "job"));
+
+		outStream << "{\"name\":";
+		write_job_name(outStream, ev.m_id, graph);
+		outStream << ",\"cat\":\"" << category << "\",\"pid\":0,\"tid\":" << ev.m_thread << ",\"ts\":" << timestamp;
+
+		switch (ev.m_type) {
+		case job_trace_begin:
+			outStream << ",\"ph\":\"B\"";
+			break;
+		case job_trace_end:
+			outStream << ",\"ph\":\"E\"";
+			break;
+		default:
+			outStream << ",\"ph\":\"i\",\"s\":\"t\"";
+			break;
+		}
+
+		outStream << ",\"args\":{\"id\":" << ev.m_id;
+
+		if (ev.m_type == job_trace_release) {
+			outStream << ",\"dependant\":" << ev.m_dependant;
+		}
+
+		outStream << "}}";
+	}
+
+	outStream << "\n]}\n";
+
+	outStream.close();
+
+	m_collected.clear();
+
+	return true;
+}
+std::uint64_t job_tracer::dropped() const noexcept
+{
+	std::uint64_t result(0);
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	for (const job_trace_ring* ring : m_rings) {
+		result += ring->dropped();
+	}
+
+	return result;
+}
+job_trace_ring& job_tracer::this_ring()
+{
+	if (t_cache.m_owner == m_id) {
+		return *t_cache.m_ring;
+	}
+
+	const std::thread::id self(std::this_thread::get_id());
+
+	std::lock_guard<std::mutex> lock(m_lock);
+
+	job_trace_ring* ring(nullptr);
+
+	for (job_trace_ring* existing : m_rings) {
+		if (existing->owner() == self) {
+			ring = existing;
+			break;
+		}
+	}
+
+	if (!ring) {
+		ring_allocator_type alloc(m_allocator);
+		ring = alloc.allocate(1);
+		new (ring) job_trace_ring((std::uint32_t)m_rings.size() + 1, self);
+
+		m_rings.push_back(ring);
+	}
+
+	t_cache.m_owner = m_id;
+	t_cache.m_ring = ring;
+
+	return *ring;
+}
+void job_tracer::try_drain(job_trace_ring& ring)
+{
+	// Recording threads never wait on a collection in progress, as that would skew the trace
+	std::unique_lock<std::mutex> lock(m_lock, std::try_to_lock);
+
+	if (lock.owns_lock()) {
+		ring.drain(m_collected);
+	}
+}
+std::uint64_t job_tracer::now() const noexcept
+{
+	return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+}
+void write_json_string(std::ofstream& outStream, const std::string_view& str)
+{
+	outStream << '\"';
+
+	for (char c : str) {
+		if (c == '\"' || c == '\\') {
+			outStream << '\\' << c;
+		}
+		else if ((unsigned char)c < 0x20) {
+			char escaped[8];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)c);
+			outStream << escaped;
+		}
+		else {
+			outStream << c;
+		}
+	}
+
+	outStream << '\"';
+}
+void write_job_name(std::ofstream& outStream, std::uint64_t id, [[maybe_unused]] job_graph& graph)
+{
+#if defined (GDUL_JOB_DEBUG)
+	if (const job_info* const info = graph.fetch_job_info(id)) {
+		if (!info->name().empty()) {
+			write_json_string(outStream, info->name());
+			return;
+		}
+	}
+#endif
+	char name[32];
+	std::snprintf(name, sizeof(name), "job %016llx", (unsigned long long)id);
+
+	write_json_string(outStream, name);
+}
+}
+}
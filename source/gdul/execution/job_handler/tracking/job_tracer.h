@@ -0,0 +1,190 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#include <gdul/execution/job_handler/globals.h>
+#include <gdul/execution/job_handler/job_handler_utility.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace gdul {
+namespace jh_detail {
+
+class job_graph;
+class job_impl;
+
+enum job_trace_event_type : std::uint8_t
+{
+	job_trace_enqueue,
+	job_trace_begin,
+	job_trace_end,
+	// A finishing job releasing one of its dependants
+	job_trace_release,
+	// Frame boundary, marked by the user
+	job_trace_frame,
+};
+
+struct job_trace_event
+{
+	// Nanoseconds since the tracer was created
+	std::uint64_t m_timestamp;
+	std::uint64_t m_id;
+	// Address of the job, telling apart instances sharing an id. Addresses are reused once a job is done with
+	std::uint64_t m_instance;
+	// Released dependant, for job_trace_release
+	std::uint64_t m_dependant;
+	std::uint64_t m_dependantInstance;
+	std::uint32_t m_thread;
+	job_trace_event_type m_type;
+};
+
+// Single producer, single consumer event ring. Written to by its thread only, and drained by the collecting thread. 
+// Events are dropped while the ring is full. Room is held back for the end events of recorded begin events, and 
+// the end events of dropped begin events are dropped as well, so that begin and end events always come in pairs
+class job_trace_ring
+{
+public:
+	job_trace_ring(std::uint32_t index, std::thread::id owner);
+
+	void push(const job_trace_event& ev) noexcept;
+
+	template <class Container>
+	void drain(Container& out);
+
+	std::uint64_t dropped() const noexcept;
+
+	// Events awaiting drain
+	std::uint32_t size() const noexcept;
+
+	std::uint32_t index() const noexcept;
+	std::thread::id owner() const noexcept;
+
+private:
+	static_assert(!(JobTraceRingSize & (JobTraceRingSize - 1)), "JobTraceRingSize must be a power of two");
+
+	std::array<job_trace_event, JobTraceRingSize> m_events;
+
+	alignas(64) std::atomic<std::uint32_t> m_head;
+	std::atomic<std::uint64_t> m_dropped;
+
+	// Producer side nesting state. Bit n of m_droppedBegins is set if the open begin event at depth n was dropped
+	std::uint64_t m_droppedBegins;
+	std::uint32_t m_depth;
+	std::uint32_t m_reservedEnds;
+
+	alignas(64) std::atomic<std::uint32_t> m_tail;
+
+	const std::thread::id m_owner;
+	const std::uint32_t m_index;
+};
+
+struct job_trace_cache
+{
+	// Id of the job_tracer the ring belongs to
+	std::uint64_t m_owner;
+	job_trace_ring* m_ring;
+};
+
+// Release mode job tracing. While enabled, enqueue, begin and end events are pushed to per thread rings without 
+// locking. Rings are moved to a shared buffer as the trace is collected, which may run concurrently with recording.
+// Recording threads also drain their own ring once it is half full, unless a collection is already under way, so 
+// that events are only dropped while a collection holds on to the buffer
+class job_tracer
+{
+public:
+	job_tracer(allocator_type alloc);
+	~job_tracer();
+
+	job_tracer(const job_tracer&) = delete;
+	job_tracer& operator=(const job_tracer&) = delete;
+
+	void set_enabled(bool enabled) noexcept;
+	bool is_enabled() const noexcept;
+
+	// Callers check is_enabled first, and record the end event of any begin event they recorded
+	void record(job_trace_event_type type, const job_impl* jb, const job_impl* dependant = nullptr);
+
+	// Moves events out of the per thread rings
+	void collect();
+
+	// Collects, then copies out the collected events, leaving them in place
+	void copy_collected(std::vector<job_trace_event>& out);
+
+	// Drops collected events recorded before until, in nanoseconds since the tracer was created
+	void discard_collected(std::uint64_t until);
+
+	// Collects, then writes Chrome trace event JSON (loadable in chrome://tracing and Perfetto). Clears the collected events
+	bool dump_chrome_trace(const std::string_view& file, job_graph& graph);
+
+	// Events lost to full rings
+	std::uint64_t dropped() const noexcept;
+
+private:
+	using ring_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<job_trace_ring>;
+	using event_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<job_trace_event>;
+
+	job_trace_ring& this_ring();
+
+	void try_drain(job_trace_ring& ring);
+
+	std::uint64_t now() const noexcept;
+
+	static thread_local job_trace_cache t_cache;
+
+	const std::chrono::steady_clock::time_point m_epoch;
+
+	// Guards ring registration and collection
+	mutable std::mutex m_lock;
+
+	std::vector<job_trace_ring*, typename std::allocator_traits<allocator_type>::template rebind_alloc<job_trace_ring*>> m_rings;
+	std::vector<job_trace_event, event_allocator_type> m_collected;
+
+	allocator_type m_allocator;
+
+	const std::uint64_t m_id;
+
+	std::atomic_bool m_enabled;
+};
+
+template<class Container>
+inline void job_trace_ring::drain(Container& out)
+{
+	const std::uint32_t tail(m_tail.load(std::memory_order_relaxed));
+	const std::uint32_t head(m_head.load(std::memory_order_acquire));
+
+	for (std::uint32_t i = tail; i != head; ++i) {
+		out.push_back(m_events[i & (JobTraceRingSize - 1)]);
+	}
+
+	m_tail.store(head, std::memory_order_release);
+}
+}
+}
+#pragma warning(pop)
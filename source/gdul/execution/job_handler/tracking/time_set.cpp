@@ -21,88 +21,307 @@
 #include <gdul/execution/job_handler/tracking/time_set.h>
 
 #if defined(GDUL_JOB_DEBUG)
-#include <memory>
-#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 namespace gdul {
 namespace jh_detail {
 
 timer time_set::s_globalTimer;
 
-time_set::time_set()
-	: m_totalTime(0.f)
+static thread_local std::uint32_t t_timeSetShard(0);
+
+time_set::shard::shard()
+	: m_count(0)
+	, m_totalNs(0)
 	, m_minTime(std::numeric_limits<float>::max())
 	, m_maxTime(-std::numeric_limits<float>::max())
 	, m_minTimepoint(0.f)
 	, m_maxTimepoint(0.f)
-	, m_completionCount(0)
-	, m_lock()
-{}
+{
+	for (std::atomic<std::uint32_t>& bucket : m_buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+time_set::time_set()
+	: m_shards()
+{
+	for (std::atomic<shard*>& s : m_shards) {
+		s.store(nullptr, std::memory_order_relaxed);
+	}
+}
 time_set::time_set(const time_set & other)
+	: time_set()
 {
 	operator=(other);
 }
 time_set::time_set(time_set&& other)
+	: time_set()
 {
-	operator=(other);
+	operator=(std::move(other));
+}
+time_set::~time_set()
+{
+	release_shards();
 }
 time_set& time_set::operator=(time_set&& other)
 {
-	return operator=(other);
+	if (this != &other) {
+		release_shards();
+
+		for (std::size_t i = 0; i < m_shards.size(); ++i) {
+			m_shards[i].store(other.m_shards[i].exchange(nullptr, std::memory_order_acquire), std::memory_order_release);
+		}
+	}
+
+	return *this;
 }
 time_set& time_set::operator=(const time_set& other)
 {
-	std::memcpy(this, &other, sizeof(time_set));
+	if (this == &other) {
+		return *this;
+	}
+
+	release_shards();
+
+	for (std::size_t i = 0; i < m_shards.size(); ++i) {
+		const shard* const from(other.m_shards[i].load(std::memory_order_acquire));
+
+		if (!from) {
+			continue;
+		}
+
+		shard* const to(new shard());
+
+		for (std::uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+			to->m_buckets[bucket].store(from->m_buckets[bucket].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		to->m_count.store(from->m_count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		to->m_totalNs.store(from->m_totalNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		to->m_minTime.store(from->m_minTime.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		to->m_maxTime.store(from->m_maxTime.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		to->m_minTimepoint.store(from->m_minTimepoint.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		to->m_maxTimepoint.store(from->m_maxTimepoint.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+		m_shards[i].store(to, std::memory_order_release);
+	}
+
 	return *this;
 }
+void time_set::set_thread_worker_index(std::uint16_t index)
+{
+	// Shard 0 is shared by threads that are not workers
+	t_timeSetShard = 1 + index % (TimeSetShards - 1);
+}
 void time_set::log_time(float completionTime)
 {
-	while (m_lock.test_and_set())
-		std::this_thread::yield();
-
-	if (completionTime < m_minTime) {
-		m_minTime = completionTime;
-		m_minTimepoint = s_globalTimer.elapsed();
-	}
-	if (m_maxTime < completionTime) {
-		m_maxTime = completionTime;
-		m_maxTimepoint = s_globalTimer.elapsed();
-	}
+	const std::uint64_t ns((std::uint64_t)(std::max(completionTime, 0.f) * 1e9));
 
-	m_totalTime += completionTime;
+	shard& s(get_shard(this_shard()));
+	s.m_buckets[to_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+	s.m_totalNs.fetch_add(ns, std::memory_order_relaxed);
+	s.m_count.fetch_add(1, std::memory_order_relaxed);
 
-	++m_completionCount;
+	// Timepoints are stored after the fact, and may be off if several threads set a new extreme at once
+	float minTime(s.m_minTime.load(std::memory_order_relaxed));
+	while (completionTime < minTime) {
+		if (s.m_minTime.compare_exchange_weak(minTime, completionTime, std::memory_order_relaxed)) {
+			s.m_minTimepoint.store(s_globalTimer.elapsed(), std::memory_order_relaxed);
+			break;
+		}
+	}
 
-	m_lock.clear();
+	float maxTime(s.m_maxTime.load(std::memory_order_relaxed));
+	while (maxTime < completionTime) {
+		if (s.m_maxTime.compare_exchange_weak(maxTime, completionTime, std::memory_order_relaxed)) {
+			s.m_maxTimepoint.store(s_globalTimer.elapsed(), std::memory_order_relaxed);
+			break;
+		}
+	}
 }
 float time_set::get_avg() const
 {
-	return m_totalTime / (m_completionCount != 0 ? m_completionCount : 1);
+	std::uint64_t count(0);
+	std::uint64_t totalNs(0);
+
+	for (const std::atomic<shard*>& entry : m_shards) {
+		if (const shard* const s = entry.load(std::memory_order_acquire)) {
+			count += s->m_count.load(std::memory_order_relaxed);
+			totalNs += s->m_totalNs.load(std::memory_order_relaxed);
+		}
+	}
+
+	return (float)((double)totalNs * 1e-9 / (double)(count != 0 ? count : 1));
 }
 
 float time_set::get_max() const
 {
-	return m_maxTime;
+	const shard* const s(find_max_shard());
+
+	return s ? s->m_maxTime.load(std::memory_order_relaxed) : -std::numeric_limits<float>::max();
 }
 
 float time_set::get_min() const
 {
-	return m_minTime;
+	const shard* const s(find_min_shard());
+
+	return s ? s->m_minTime.load(std::memory_order_relaxed) : std::numeric_limits<float>::max();
 }
 
 float time_set::get_minTimepoint() const
 {
-	return m_minTimepoint;
+	const shard* const s(find_min_shard());
+
+	return s ? s->m_minTimepoint.load(std::memory_order_relaxed) : 0.f;
 }
 
 float time_set::get_maxTimepoint() const
 {
-	return m_maxTimepoint;
+	const shard* const s(find_max_shard());
+
+	return s ? s->m_maxTimepoint.load(std::memory_order_relaxed) : 0.f;
+}
+float time_set::get_percentile(float fraction) const
+{
+	std::array<std::uint64_t, Buckets> merged{};
+	std::uint64_t total(0);
+
+	for (const std::atomic<shard*>& entry : m_shards) {
+		const shard* const s(entry.load(std::memory_order_acquire));
+
+		if (!s) {
+			continue;
+		}
+
+		for (std::uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+			const std::uint32_t count(s->m_buckets[bucket].load(std::memory_order_relaxed));
+			merged[bucket] += count;
+			total += count;
+		}
+	}
+
+	if (!total) {
+		return 0.f;
+	}
+
+	const double clamped(std::min(std::max((double)fraction, 0.0), 1.0));
+	const std::uint64_t rank(std::max<std::uint64_t>((std::uint64_t)std::ceil(clamped * (double)total), 1));
+
+	std::uint64_t accumulated(0);
+	for (std::uint32_t bucket = 0; bucket < Buckets; ++bucket) {
+		accumulated += merged[bucket];
+
+		if (!(accumulated < rank)) {
+			return std::min(std::max(from_bucket(bucket), get_min()), get_max());
+		}
+	}
+
+	return get_max();
 }
 std::size_t time_set::get_completion_count() const
 {
-	return m_completionCount;
+	std::uint64_t count(0);
+
+	for (const std::atomic<shard*>& entry : m_shards) {
+		if (const shard* const s = entry.load(std::memory_order_acquire)) {
+			count += s->m_count.load(std::memory_order_relaxed);
+		}
+	}
+
+	return (std::size_t)count;
+}
+std::uint32_t time_set::to_bucket(std::uint64_t ns)
+{
+	if (ns < (1ull << TimeSetMinExponent)) {
+		return (std::uint32_t)(ns >> (TimeSetMinExponent - TimeSetSubBucketBits));
+	}
+
+	const std::uint32_t msb((std::uint32_t)std::ilogb((double)ns));
+	const std::uint32_t octave(msb - TimeSetMinExponent);
+
+	if (!(octave < TimeSetOctaves)) {
+		return Buckets - 1;
+	}
+
+	const std::uint32_t sub((std::uint32_t)(ns >> (msb - TimeSetSubBucketBits)) & (SubBuckets - 1));
+
+	return SubBuckets * (octave + 1) + sub;
+}
+float time_set::from_bucket(std::uint32_t bucket)
+{
+	std::uint64_t lower(0);
+	std::uint64_t width(0);
+
+	if (bucket < SubBuckets) {
+		width = 1ull << (TimeSetMinExponent - TimeSetSubBucketBits);
+		lower = bucket * width;
+	}
+	else {
+		const std::uint32_t msb(TimeSetMinExponent + bucket / SubBuckets - 1);
+
+		width = 1ull << (msb - TimeSetSubBucketBits);
+		lower = (1ull << msb) + (bucket % SubBuckets) * width;
+	}
+
+	return (float)((double)(lower + width / 2) * 1e-9);
+}
+std::uint32_t time_set::this_shard()
+{
+	return t_timeSetShard;
+}
+time_set::shard& time_set::get_shard(std::uint32_t index)
+{
+	shard* s(m_shards[index].load(std::memory_order_acquire));
+
+	if (!s) {
+		shard* const created(new shard());
+
+		if (m_shards[index].compare_exchange_strong(s, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			s = created;
+		}
+		else {
+			delete created;
+		}
+	}
+
+	return *s;
+}
+const time_set::shard* time_set::find_min_shard() const
+{
+	const shard* result(nullptr);
+
+	for (const std::atomic<shard*>& entry : m_shards) {
+		const shard* const s(entry.load(std::memory_order_acquire));
+
+		if (s && (!result || s->m_minTime.load(std::memory_order_relaxed) < result->m_minTime.load(std::memory_order_relaxed))) {
+			result = s;
+		}
+	}
+
+	return result;
+}
+const time_set::shard* time_set::find_max_shard() const
+{
+	const shard* result(nullptr);
+
+	for (const std::atomic<shard*>& entry : m_shards) {
+		const shard* const s(entry.load(std::memory_order_acquire));
+
+		if (s && (!result || result->m_maxTime.load(std::memory_order_relaxed) < s->m_maxTime.load(std::memory_order_relaxed))) {
+			result = s;
+		}
+	}
+
+	return result;
+}
+void time_set::release_shards()
+{
+	for (std::atomic<shard*>& entry : m_shards) {
+		delete entry.exchange(nullptr, std::memory_order_acquire);
+	}
 }
 }
 }
-#endif
\ No newline at end of file
+#endif
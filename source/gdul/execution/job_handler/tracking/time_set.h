@@ -20,24 +20,35 @@
 
 #pragma once
 
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
 #include <gdul/execution/job_handler/globals.h>
 
 #if defined(GDUL_JOB_DEBUG)
 #include <gdul/execution/job_handler/tracking/timer.h>
+#include <array>
 #include <atomic>
 
 namespace gdul {
 namespace jh_detail {
 
+// Log-linear latency histogram. Samples are counted without locking into shards keyed by worker index, 
+// which are merged as the set is read. A shard is allocated once its first sample is logged, so a set 
+// only holds shards for the workers that actually ran its job
 class time_set
 {
 public:
 	time_set();
 	time_set(const time_set& other);
 	time_set(time_set&& other);
+	~time_set();
 	time_set& operator=(time_set&& other);
 	time_set& operator=(const time_set& other);
 
+	// Samples logged by the calling thread go to the shard of this worker. Threads that are not workers share one
+	static void set_thread_worker_index(std::uint16_t index);
+
 	void log_time(float completionTime);
 
 	float get_avg() const;
@@ -46,21 +57,51 @@ public:
 	float get_minTimepoint() const;
 	float get_maxTimepoint() const;
 
+	// Approximate time below which the given fraction [0, 1] of samples fall
+	float get_percentile(float fraction) const;
+
 	std::size_t get_completion_count() const;
 
 private:
-	static timer s_globalTimer;
+	static constexpr std::uint32_t SubBuckets = 1u << TimeSetSubBucketBits;
+	// The first SubBuckets buckets linearly cover times below 2^TimeSetMinExponent ns
+	static constexpr std::uint32_t Buckets = SubBuckets * (TimeSetOctaves + 1);
+
+	// Padded, so that threads logging to neighbouring shards do not share cache lines. Extremes are 
+	// kept per shard as well, so that logging only ever writes to the shard of the calling worker
+	struct alignas(64) shard
+	{
+		shard();
+
+		std::array<std::atomic<std::uint32_t>, Buckets> m_buckets;
+		std::atomic<std::uint64_t> m_count;
+		std::atomic<std::uint64_t> m_totalNs;
 
-	std::atomic_flag m_lock;
+		std::atomic<float> m_minTime;
+		std::atomic<float> m_maxTime;
+		std::atomic<float> m_minTimepoint;
+		std::atomic<float> m_maxTimepoint;
+	};
 
-	std::size_t m_completionCount;
+	static std::uint32_t to_bucket(std::uint64_t ns);
+	// Midpoint of the bucket range, in seconds
+	static float from_bucket(std::uint32_t bucket);
+
+	static std::uint32_t this_shard();
+
+	shard& get_shard(std::uint32_t index);
+
+	// The shard holding the lowest / highest time, if any
+	const shard* find_min_shard() const;
+	const shard* find_max_shard() const;
+
+	void release_shards();
+
+	static timer s_globalTimer;
 
-	float m_totalTime;
-	float m_minTime;
-	float m_maxTime;
-	float m_minTimepoint;
-	float m_maxTimepoint;
+	std::array<std::atomic<shard*>, TimeSetShards> m_shards;
 };
 }
 }
-#endif
\ No newline at end of file
+#endif
+#pragma warning(pop)
@@ -0,0 +1,173 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gdul/execution/job_handler/work_stealing_deque.h>
+
+#include <cassert>
+#include <memory>
+
+namespace gdul {
+namespace jh_detail {
+
+work_stealing_deque::work_stealing_deque() noexcept
+	: m_top(0)
+	, m_bottom(0)
+	, m_buffer(nullptr)
+	, m_allocator()
+{
+}
+work_stealing_deque::~work_stealing_deque()
+{
+	buffer* current(m_buffer.load(std::memory_order_relaxed));
+
+	while (current) {
+		buffer* const retired(current->m_retired);
+
+		const std::size_t byteSize(sizeof(buffer) + sizeof(std::atomic<job_impl*>) * current->m_capacity);
+
+		for (std::int64_t i = 0; i < current->m_capacity; ++i) {
+			(*current)[i].~atomic();
+		}
+		current->~buffer();
+
+		m_allocator.deallocate((std::uint8_t*)current, byteSize);
+
+		current = retired;
+	}
+}
+void work_stealing_deque::init(allocator_type alloc)
+{
+	assert(!m_buffer.load(std::memory_order_relaxed) && "Deque already initialized");
+
+	m_allocator = alloc;
+	m_buffer.store(make_buffer(WorkStealingDequeInitSize), std::memory_order_release);
+}
+void work_stealing_deque::push(job_impl* jb)
+{
+	const std::int64_t bottom(m_bottom.load(std::memory_order_relaxed));
+	const std::int64_t top(m_top.load(std::memory_order_acquire));
+
+	buffer* items(m_buffer.load(std::memory_order_relaxed));
+
+	if (!(bottom - top < items->m_capacity)) {
+		items = grow(items, top, bottom);
+	}
+
+	(*items)[bottom].store(jb, std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_release);
+
+	m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+job_impl* work_stealing_deque::pop() noexcept
+{
+	const std::int64_t bottom(m_bottom.load(std::memory_order_relaxed) - 1);
+
+	buffer* const items(m_buffer.load(std::memory_order_relaxed));
+
+	m_bottom.store(bottom, std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	std::int64_t top(m_top.load(std::memory_order_relaxed));
+
+	if (bottom < top) {
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	job_impl* out((*items)[bottom].load(std::memory_order_relaxed));
+
+	if (top == bottom) {
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			out = nullptr;
+		}
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	return out;
+}
+job_impl* work_stealing_deque::steal() noexcept
+{
+	std::int64_t top(m_top.load(std::memory_order_acquire));
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	const std::int64_t bottom(m_bottom.load(std::memory_order_acquire));
+
+	if (!(top < bottom)) {
+		return nullptr;
+	}
+
+	buffer* const items(m_buffer.load(std::memory_order_acquire));
+
+	job_impl* const out((*items)[top].load(std::memory_order_relaxed));
+
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+
+	return out;
+}
+bool work_stealing_deque::empty() const noexcept
+{
+	const std::int64_t bottom(m_bottom.load(std::memory_order_relaxed));
+	const std::int64_t top(m_top.load(std::memory_order_relaxed));
+
+	return !(top < bottom);
+}
+std::atomic<job_impl*>& work_stealing_deque::buffer::operator[](std::int64_t index) noexcept
+{
+	std::atomic<job_impl*>* const items((std::atomic<job_impl*>*)(this + 1));
+
+	return items[index & m_mask];
+}
+typename work_stealing_deque::buffer* work_stealing_deque::make_buffer(std::int64_t capacity)
+{
+	assert(!(capacity & (capacity - 1)) && "Capacity must be a power of two");
+
+	const std::size_t byteSize(sizeof(buffer) + sizeof(std::atomic<job_impl*>) * capacity);
+
+	std::uint8_t* const block(m_allocator.allocate(byteSize));
+
+	buffer* const out(new (block) buffer{ nullptr, capacity, capacity - 1 });
+
+	for (std::int64_t i = 0; i < capacity; ++i) {
+		new (&(*out)[i]) std::atomic<job_impl*>(nullptr);
+	}
+
+	return out;
+}
+typename work_stealing_deque::buffer* work_stealing_deque::grow(buffer* from, std::int64_t top, std::int64_t bottom)
+{
+	buffer* const to(make_buffer(from->m_capacity * 2));
+
+	for (std::int64_t i = top; i < bottom; ++i) {
+		(*to)[i].store((*from)[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	to->m_retired = from;
+
+	m_buffer.store(to, std::memory_order_release);
+
+	return to;
+}
+}
+}
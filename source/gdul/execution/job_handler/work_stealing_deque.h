@@ -0,0 +1,78 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#include <gdul/execution/job_handler/job_handler_utility.h>
+
+#include <atomic>
+#include <new>
+
+namespace gdul {
+namespace jh_detail {
+
+class job_impl;
+
+// Chase-Lev style deque. The owning thread pushes and pops at the bottom (LIFO), 
+// other threads steal from the top (FIFO). Storage grows on demand. Retired buffers 
+// are kept until destruction, since thieves may still be reading from them
+class work_stealing_deque
+{
+public:
+	work_stealing_deque() noexcept;
+	~work_stealing_deque();
+
+	void init(allocator_type alloc);
+
+	// Owner only
+	void push(job_impl* jb);
+	
+	// Owner only
+	job_impl* pop() noexcept;
+
+	job_impl* steal() noexcept;
+
+	bool empty() const noexcept;
+
+private:
+	struct buffer
+	{
+		std::atomic<job_impl*>& operator[](std::int64_t index) noexcept;
+
+		buffer* m_retired;
+		std::int64_t m_capacity;
+		std::int64_t m_mask;
+	};
+
+	buffer* make_buffer(std::int64_t capacity);
+	buffer* grow(buffer* from, std::int64_t top, std::int64_t bottom);
+
+	alignas(std::hardware_destructive_interference_size) std::atomic<std::int64_t> m_top;
+	alignas(std::hardware_destructive_interference_size) std::atomic<std::int64_t> m_bottom;
+	std::atomic<buffer*> m_buffer;
+
+	allocator_type m_allocator;
+};
+}
+}
+#pragma warning(pop)
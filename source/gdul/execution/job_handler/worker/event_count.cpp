@@ -0,0 +1,186 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gdul/execution/job_handler/worker/event_count.h>
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#if defined(_WIN64) | defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace gdul {
+namespace jh_detail {
+namespace ec_detail {
+#if defined(_WIN64) | defined(_WIN32)
+bool wait_on_address(std::atomic<std::uint32_t>* address, std::uint32_t expected, std::chrono::microseconds timeout) noexcept
+{
+	const DWORD ms((DWORD)std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count(), 1));
+
+	if (!WaitOnAddress((volatile void*)address, &expected, sizeof(expected), ms)) {
+		return GetLastError() != ERROR_TIMEOUT;
+	}
+	return true;
+}
+std::uint32_t wake_by_address(std::atomic<std::uint32_t>* address, std::uint32_t n) noexcept
+{
+	if (n == std::numeric_limits<std::uint32_t>::max()) {
+		WakeByAddressAll((void*)address);
+	}
+	else {
+		for (std::uint32_t i = 0; i < n; ++i) {
+			WakeByAddressSingle((void*)address);
+		}
+	}
+
+	return n;
+}
+#elif defined(__linux__)
+bool wait_on_address(std::atomic<std::uint32_t>* address, std::uint32_t expected, std::chrono::microseconds timeout) noexcept
+{
+	timespec ts;
+	ts.tv_sec = (time_t)(timeout.count() / 1000000);
+	ts.tv_nsec = (long)((timeout.count() % 1000000) * 1000);
+
+	const long result(syscall(SYS_futex, (std::uint32_t*)address, FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0));
+
+	return !(result == -1 && errno == ETIMEDOUT);
+}
+std::uint32_t wake_by_address(std::atomic<std::uint32_t>* address, std::uint32_t n) noexcept
+{
+	const int toWake((int)std::min<std::uint32_t>(n, (std::uint32_t)std::numeric_limits<int>::max()));
+
+	const long result(syscall(SYS_futex, (std::uint32_t*)address, FUTEX_WAKE_PRIVATE, toWake, nullptr, nullptr, 0));
+
+	return result < 0 ? 0 : (std::uint32_t)result;
+}
+#else
+bool wait_on_address(std::atomic<std::uint32_t>* address, std::uint32_t expected, std::chrono::microseconds timeout) noexcept
+{
+	// No native address waiting available. Fall back on a short sleep
+	if (address->load(std::memory_order_relaxed) == expected) {
+		std::this_thread::sleep_for(std::min(timeout, std::chrono::microseconds(100)));
+	}
+	return true;
+}
+std::uint32_t wake_by_address(std::atomic<std::uint32_t>*, std::uint32_t n) noexcept
+{
+	return n;
+}
+#endif
+}
+event_count::event_count() noexcept
+	: m_epoch(0)
+	, m_waiters(0)
+	, m_parks(0)
+	, m_wakes(0)
+	, m_timeouts(0)
+{
+}
+typename event_count::key_type event_count::prepare_wait() noexcept
+{
+	m_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+	return m_epoch.load(std::memory_order_seq_cst);
+}
+void event_count::cancel_wait() noexcept
+{
+	m_waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+bool event_count::wait(key_type key, std::chrono::microseconds timeout) noexcept
+{
+	bool result(true);
+
+	if (m_epoch.load(std::memory_order_acquire) == key) {
+		m_parks.fetch_add(1, std::memory_order_relaxed);
+
+		result = ec_detail::wait_on_address(&m_epoch, key, timeout);
+
+		if (!result) {
+			m_timeouts.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	m_waiters.fetch_sub(1, std::memory_order_relaxed);
+
+	return result;
+}
+std::uint32_t event_count::notify(std::uint32_t n) noexcept
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	return notify_fenced(n);
+}
+void event_count::notify_all() noexcept
+{
+	notify(std::numeric_limits<std::uint32_t>::max());
+}
+std::uint32_t event_count::notify_fenced(std::uint32_t n) noexcept
+{
+	if (!n || !m_waiters.load(std::memory_order_relaxed)) {
+		return 0;
+	}
+
+	return wake(n);
+}
+std::uint64_t event_count::park_count() const noexcept
+{
+	return m_parks.load(std::memory_order_relaxed);
+}
+std::uint64_t event_count::wake_count() const noexcept
+{
+	return m_wakes.load(std::memory_order_relaxed);
+}
+std::uint64_t event_count::timeout_count() const noexcept
+{
+	return m_timeouts.load(std::memory_order_relaxed);
+}
+std::uint32_t event_count::wake(std::uint32_t n) noexcept
+{
+	const std::uint32_t waiters(m_waiters.load(std::memory_order_relaxed));
+	const std::uint32_t toWake(std::min(n, waiters));
+
+	if (!toWake) {
+		return 0;
+	}
+
+	m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+	// Waking every announced waiter takes one call where only a count is known to be woken (Windows), and the 
+	// reported count is never taken to exceed the announced waiters
+	const std::uint32_t woken(std::min(ec_detail::wake_by_address(&m_epoch, toWake == waiters ? std::numeric_limits<std::uint32_t>::max() : toWake), toWake));
+
+	m_wakes.fetch_add(woken, std::memory_order_relaxed);
+
+	return woken;
+}
+}
+}
@@ -0,0 +1,68 @@
+// Copyright(c) 2020 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace gdul {
+namespace jh_detail {
+
+// Event count used for parking idle workers. Each worker parks on its own, so that notifiers may pick which 
+// workers to wake. Waiters announce themselves using prepare_wait, re-check their wait condition and then 
+// either cancel_wait or wait using the returned key. Notifiers only enter the kernel if there are announced waiters
+class event_count
+{
+public:
+	using key_type = std::uint32_t;
+
+	event_count() noexcept;
+
+	key_type prepare_wait() noexcept;
+	void cancel_wait() noexcept;
+
+	// Returns false on timeout
+	bool wait(key_type key, std::chrono::microseconds timeout) noexcept;
+
+	// Wakes up to n waiters. Returns the number woken
+	std::uint32_t notify(std::uint32_t n) noexcept;
+	void notify_all() noexcept;
+
+	// As notify, for callers that have already issued a sequentially consistent fence, such as when notifying many in turn
+	std::uint32_t notify_fenced(std::uint32_t n) noexcept;
+
+	std::uint64_t park_count() const noexcept;
+	std::uint64_t wake_count() const noexcept;
+	std::uint64_t timeout_count() const noexcept;
+
+private:
+	std::uint32_t wake(std::uint32_t n) noexcept;
+
+	std::atomic<key_type> m_epoch;
+	std::atomic<std::uint32_t> m_waiters;
+
+	std::atomic<std::uint64_t> m_parks;
+	std::atomic<std::uint64_t> m_wakes;
+	std::atomic<std::uint64_t> m_timeouts;
+};
+}
+}
@@ -23,6 +23,9 @@
 #include <gdul/execution/job_handler/job_queue.h>
 #include <gdul/execution/job_handler/job/job.h>
 #include <gdul/execution/job_handler/job/job_impl.h>
+#include <gdul/execution/job_handler/worker/event_count.h>
+#include <gdul/execution/job_handler/job_timer_queue.h>
+#include <gdul/execution/thread/cpu_topology.h>
 
 #include <cassert>
 #include <algorithm>
@@ -45,24 +48,40 @@ worker_impl::worker_impl()
 	, m_onDisable([](){})
 	, m_isEnabled(false)
 	, m_targets{}
+	, m_parking(nullptr)
+	, m_timers(nullptr)
+	, m_numaNode(Numa_Node_Unknown)
 	, m_sleepThreshhold(std::numeric_limits<std::uint16_t>::max())
 	, m_isActive(false)
 	, m_queuePushSync(0)
 	, m_queueCount(0)
 	, m_queueIndex(0)
+	, m_jobsExecuted(0)
+	, m_busyNs(0)
+	, m_idleNs(0)
+	, m_sleepNs(0)
+	, m_fetchNs(0)
 {
 }
-worker_impl::worker_impl(thread&& thrd)
+worker_impl::worker_impl(thread&& thrd, event_count* parking, job_timer_queue* timers)
 	: m_thread()
 	, m_onEnable([]() {})
 	, m_onDisable([]() {})
 	, m_isEnabled(false)
 	, m_targets{}
+	, m_parking(parking)
+	, m_timers(timers)
+	, m_numaNode(Numa_Node_Unknown)
 	, m_sleepThreshhold(80)
 	, m_isActive(false)
 	, m_queuePushSync(0)
 	, m_queueCount(0)
 	, m_queueIndex(0)
+	, m_jobsExecuted(0)
+	, m_busyNs(0)
+	, m_idleNs(0)
+	, m_sleepNs(0)
+	, m_fetchNs(0)
 {
 	m_thread.swap(thrd);
 
@@ -90,7 +109,15 @@ worker_impl & worker_impl::operator=(worker_impl && other) noexcept
 	m_lastJobTimepoint = other.m_lastJobTimepoint;
 	m_isActive.store(other.m_isActive.load(std::memory_order_relaxed), std::memory_order_release);
 	m_queueIndex = other.m_queueIndex;
-	std::copy(other.m_targets.begin(), other.m_targets.end(), m_targets.begin());
+	m_parking = other.m_parking;
+	m_timers = other.m_timers;
+	m_numaNode = other.m_numaNode;
+	m_targets.swap(other.m_targets);
+	m_jobsExecuted.store(other.m_jobsExecuted.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	m_busyNs.store(other.m_busyNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	m_idleNs.store(other.m_idleNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	m_sleepNs.store(other.m_sleepNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	m_fetchNs.store(other.m_fetchNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
 
 	return *this;
 }
@@ -105,7 +132,13 @@ void worker_impl::enable()
 }
 bool worker_impl::disable()
 {
-	return m_isActive.exchange(false, std::memory_order_release);
+	const bool result(m_isActive.exchange(false, std::memory_order_release));
+
+	if (m_parking) {
+		m_parking->notify_all();
+	}
+
+	return result;
 }
 void worker_impl::refresh_sleep_timer()
 {
@@ -137,14 +170,31 @@ void worker_impl::set_run_on_disable(delegate<void()>&& toCall)
 }
 void worker_impl::add_assignment(job_queue* queue)
 {
-	const std::uint8_t ix(m_queuePushSync.fetch_add(1, std::memory_order_acq_rel));
-	assert(ix < MaxWorkerTargets && "Max worker targets exceeded");
+	const std::uint16_t ix(m_queuePushSync.fetch_add(1, std::memory_order_acq_rel));
 
-	m_targets[ix] = queue;
+	m_targets.claim(ix) = queue;
 
 	m_queueCount.fetch_add(1,std::memory_order_release);
 
-	queue->m_assignees.fetch_add(1, std::memory_order_relaxed);
+	const std::uint16_t assignee(queue->m_assignees.fetch_add(1, std::memory_order_acq_rel));
+
+	if (m_parking) {
+		queue->m_parkings.claim(assignee).store(m_parking, std::memory_order_release);
+
+		// Jobs submitted before this worker could be found by the queue would otherwise wait out the park timeout
+		m_parking->notify_all();
+	}
+}
+void worker_impl::set_numa_node(std::uint16_t node)
+{
+	m_numaNode = node;
+}
+std::uint16_t worker_impl::get_numa_node() const
+{
+	if (m_numaNode == Numa_Node_Unknown) {
+		return get_cpu_topology().current_numa_node();
+	}
+	return m_numaNode;
 }
 void worker_impl::on_enable()
 {
@@ -157,7 +207,11 @@ void worker_impl::on_disable()
 void worker_impl::idle()
 {
 	if (is_sleepy()) {
-		std::this_thread::sleep_for(std::chrono::microseconds(10));
+		const std::chrono::microseconds timeout(idle_timeout(std::chrono::microseconds(10)));
+
+		if (timeout.count()) {
+			std::this_thread::sleep_for(timeout);
+		}
 	}
 	else {
 		std::this_thread::yield();
@@ -165,19 +219,37 @@ void worker_impl::idle()
 }
 void worker_impl::work()
 {
+	// One clock read per phase, each reading closing the previous phase
+	std::chrono::steady_clock::time_point from(std::chrono::steady_clock::now());
+
 	while (is_active()) {
+		job_impl_ptr jb(fetch_job());
+
+		const std::chrono::steady_clock::time_point fetched(std::chrono::steady_clock::now());
+		accumulate(m_fetchNs, fetched - from);
 
-		if (job_impl_shared_ptr jb = fetch_job()) {
+		std::atomic<std::uint64_t>* phase(&m_busyNs);
+
+		if (jb) {
 			consume_job(std::move(jb));
 		}
+		else if (m_parking && is_sleepy()) {
+			if (!park()) {
+				phase = &m_sleepNs;
+			}
+		}
 		else {
 			idle();
+			phase = &m_idleNs;
 		}
+
+		from = std::chrono::steady_clock::now();
+		accumulate(*phase, from - fetched);
 	}
 }
 bool worker_impl::try_consume_from_once(job_queue* consumeFrom)
 {
-	if (job_impl_shared_ptr jb = consumeFrom->fetch_job()) {
+	if (job_impl_ptr jb = consumeFrom->take_job()) {
 
 		consume_job(std::move(jb));
 
@@ -186,6 +258,25 @@ bool worker_impl::try_consume_from_once(job_queue* consumeFrom)
 
 	return false;
 }
+worker_stats worker_impl::get_stats() const noexcept
+{
+	worker_stats stats;
+	stats.jobsExecuted = m_jobsExecuted.load(std::memory_order_relaxed);
+	stats.busyTime = (double)m_busyNs.load(std::memory_order_relaxed) * 1e-9;
+	stats.idleTime = (double)m_idleNs.load(std::memory_order_relaxed) * 1e-9;
+	stats.sleepTime = (double)m_sleepNs.load(std::memory_order_relaxed) * 1e-9;
+	stats.fetchTime = (double)m_fetchNs.load(std::memory_order_relaxed) * 1e-9;
+
+	return stats;
+}
+std::uint16_t worker_impl::assignment_count() const noexcept
+{
+	return m_queueCount.load(std::memory_order_acquire);
+}
+job_queue* worker_impl::get_assignment(std::uint16_t index) const noexcept
+{
+	return m_targets[index];
+}
 const thread& worker_impl::get_thread() const
 {
 	return m_thread;
@@ -194,7 +285,7 @@ thread& worker_impl::get_thread()
 {
 	return m_thread;
 }
-void worker_impl::consume_job(job_impl_shared_ptr&& jb)
+void worker_impl::consume_job(job_impl_ptr&& jb)
 {
 	job swap(std::move(job::this_job));
 
@@ -202,20 +293,72 @@ void worker_impl::consume_job(job_impl_shared_ptr&& jb)
 	job::this_job.m_impl->operator()();
 	job::this_job = std::move(swap);
 
+	accumulate(m_jobsExecuted, 1);
+
 	job_handler_impl::t_items.this_worker_impl->refresh_sleep_timer();
 }
-typename worker_impl::job_impl_shared_ptr worker_impl::fetch_job()
+bool worker_impl::park()
 {
-	const std::uint8_t queueCount(m_queueCount.load(std::memory_order_acquire));
+	const event_count::key_type key(m_parking->prepare_wait());
 
-	for (std::uint8_t i = 0; i < queueCount; ++i) {
-		const std::uint8_t ix(m_queueIndex++ % queueCount);
-		if (job_impl_shared_ptr out = m_targets[ix]->fetch_job()) {
+	// Re-check after announcing ourselves, so that no submission may slip by unnoticed
+	if (!is_active()) {
+		m_parking->cancel_wait();
+		return false;
+	}
+	if (job_impl_ptr jb = fetch_job()) {
+		m_parking->cancel_wait();
+		consume_job(std::move(jb));
+		return true;
+	}
+
+	const std::chrono::microseconds timeout(idle_timeout(std::chrono::milliseconds(WorkerParkTimeoutMs)));
+
+	if (!timeout.count()) {
+		m_parking->cancel_wait();
+		return false;
+	}
+
+	m_parking->wait(key, timeout);
+
+	return false;
+}
+void worker_impl::accumulate(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+void worker_impl::accumulate(std::atomic<std::uint64_t>& counter, std::chrono::steady_clock::duration duration) noexcept
+{
+	accumulate(counter, (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+std::chrono::microseconds worker_impl::idle_timeout(std::chrono::microseconds max) const
+{
+	if (!m_timers) {
+		return max;
+	}
+
+	return std::min(max, m_timers->time_until_next());
+}
+job_impl_ptr worker_impl::fetch_job()
+{
+	if (m_timers) {
+		m_timers->advance();
+	}
+
+	const std::uint16_t queueCount(m_queueCount.load(std::memory_order_acquire));
+
+	for (std::uint16_t i = 0; i < queueCount; ++i) {
+		const std::uint16_t ix(m_queueIndex++ % queueCount);
+		if (job_impl_ptr out = m_targets[ix]->take_job()) {
 			return out;
 		}
 	}
 
-	return job_impl_shared_ptr(nullptr);
+	return job_impl_ptr(nullptr);
+}
+std::uint16_t this_numa_node() noexcept
+{
+	return job_handler_impl::t_items.this_worker_impl->get_numa_node();
 }
 }
 }
\ No newline at end of file
@@ -28,24 +28,24 @@
 #include <gdul/execution/job_handler/worker/worker.h>
 #include <gdul/execution/job_handler/job/job.h>
 #include <gdul/execution/thread/thread.h>
+#include <gdul/execution/job_handler/segmented_array.h>
 
 #include <chrono>
 #include <atomic>
 #include <thread>
-#include <array>
 
 namespace gdul {
 namespace jh_detail
 {
 class job_handler_impl;
+class event_count;
+class job_timer_queue;
 
 class alignas(64) worker_impl
 {
 public:
-	using job_impl_shared_ptr = shared_ptr<job_impl>;
-
 	worker_impl();
-	worker_impl(thread&& thrd);
+	worker_impl(thread&& thrd, event_count* parking, job_timer_queue* timers);
 	~worker_impl();
 
 	worker_impl& operator=(worker_impl&& other) noexcept;
@@ -67,6 +67,9 @@ public:
 
 	void add_assignment(job_queue* queue);
 
+	void set_numa_node(std::uint16_t node);
+	std::uint16_t get_numa_node() const;
+
 	void on_enable();
 	void on_disable();
 
@@ -75,12 +78,28 @@ public:
 
 	bool try_consume_from_once(job_queue* consumeFrom);
 
+	// Not safe to call while the worker is being moved into place
+	worker_stats get_stats() const noexcept;
+
+	std::uint16_t assignment_count() const noexcept;
+	job_queue* get_assignment(std::uint16_t index) const noexcept;
+
 	const thread& get_thread() const;
 	thread& get_thread();
 
 private:
-	void consume_job(job_impl_shared_ptr&& jb);
-	typename job_impl_shared_ptr fetch_job();
+	void consume_job(job_impl_ptr&& jb);
+	job_impl_ptr fetch_job();
+
+	// Returns true if a job was found and consumed in place of parking
+	bool park();
+
+	// Counters are written by the owning thread only
+	static void accumulate(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept;
+	static void accumulate(std::atomic<std::uint64_t>& counter, std::chrono::steady_clock::duration duration) noexcept;
+
+	// Time to sleep while idle, shortened to the next timer deadline
+	std::chrono::microseconds idle_timeout(std::chrono::microseconds max) const;
 
 	thread m_thread;
 
@@ -90,16 +109,27 @@ private:
 	std::chrono::high_resolution_clock::time_point m_lastJobTimepoint;
 	std::chrono::high_resolution_clock m_sleepTimer;
 
-	std::array<job_queue*, MaxWorkerTargets> m_targets;
+	segmented_array<job_queue*, WorkerTargetBlockSize, allocator_type> m_targets;
+
+	event_count* m_parking;
+	job_timer_queue* m_timers;
+
+	std::uint16_t m_numaNode;
 
 	std::uint16_t m_sleepThreshhold;
 
 	std::atomic_bool m_isEnabled;
 	std::atomic_bool m_isActive;
-	std::atomic_uint8_t m_queuePushSync;
-	std::atomic_uint8_t m_queueCount;
+	std::atomic_uint16_t m_queuePushSync;
+	std::atomic_uint16_t m_queueCount;
+
+	std::uint16_t m_queueIndex;
 
-	std::uint8_t m_queueIndex;
+	std::atomic<std::uint64_t> m_jobsExecuted;
+	std::atomic<std::uint64_t> m_busyNs;
+	std::atomic<std::uint64_t> m_idleNs;
+	std::atomic<std::uint64_t> m_sleepNs;
+	std::atomic<std::uint64_t> m_fetchNs;
 };
 }
 }
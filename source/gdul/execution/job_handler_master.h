@@ -22,8 +22,11 @@
 
 #include <gdul/execution/job_handler/job/job.h>
 #include <gdul/execution/job_handler/job_handler.h>
+#include <gdul/execution/job_handler/parallel_algorithm.h>
 #include <gdul/execution/job_handler/worker/worker.h>
 #include <gdul/execution/job_handler/job/batch_job.h>
 #include <gdul/execution/job_handler/job/batch_job_impl.h>
+#include <gdul/execution/job_handler/job/task.h>
+#include <gdul/execution/job_handler/job/job_graph_template.h>
 #include <gdul/execution/job_handler/job_queue.h>
 #include <gdul/execution/job_handler/globals.h>
@@ -0,0 +1,282 @@
+// Copyright(c) 2021 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace gdul {
+namespace ct_detail {
+bool read_line(const std::string& path, std::string& out)
+{
+	std::ifstream file(path);
+
+	if (!file.is_open()) {
+		return false;
+	}
+
+	std::getline(file, out);
+
+	return true;
+}
+bool read_value(const std::string& path, std::uint16_t& out)
+{
+	std::string line;
+	if (!read_line(path, line) || line.empty()) {
+		return false;
+	}
+
+	try {
+		out = (std::uint16_t)std::stoul(line);
+	}
+	catch (...) {
+		return false;
+	}
+
+	return true;
+}
+// Parses kernel cpu list format. Ex: "0-3,8,10-11"
+std::vector<std::uint16_t> parse_list(const std::string& list)
+{
+	std::vector<std::uint16_t> out;
+
+	std::size_t at(0);
+	while (at < list.size()) {
+		std::size_t end(list.find(',', at));
+		if (end == std::string::npos) {
+			end = list.size();
+		}
+
+		const std::string range(list.substr(at, end - at));
+		const std::size_t dash(range.find('-'));
+
+		try {
+			const unsigned long first(std::stoul(range.substr(0, dash)));
+			const unsigned long last(dash == std::string::npos ? first : std::stoul(range.substr(dash + 1)));
+
+			for (unsigned long i = first; i <= last; ++i) {
+				out.push_back((std::uint16_t)i);
+			}
+		}
+		catch (...) {
+		}
+
+		at = end + 1;
+	}
+
+	return out;
+}
+}
+
+cpu_topology::cpu_topology()
+{
+	if (!discover_sysfs()) {
+		discover_fallback();
+	}
+
+	build_lookups();
+}
+std::size_t cpu_topology::core_count() const noexcept
+{
+	return m_cores.size();
+}
+std::size_t cpu_topology::numa_node_count() const noexcept
+{
+	return m_nodes.size();
+}
+const logical_core& cpu_topology::core(std::size_t index) const
+{
+	assert(index < m_cores.size() && "Core index out of range");
+	return m_cores[index];
+}
+const std::vector<std::uint16_t>& cpu_topology::numa_node_cores(std::size_t node) const
+{
+	assert(node < m_nodes.size() && "Node index out of range");
+	return m_nodes[node];
+}
+const std::vector<std::uint16_t>& cpu_topology::placement_order() const noexcept
+{
+	return m_placementOrder;
+}
+std::uint16_t cpu_topology::numa_node_of(std::uint16_t coreIndex) const noexcept
+{
+	if (coreIndex < m_coreToNode.size()) {
+		return m_coreToNode[coreIndex];
+	}
+	return 0;
+}
+std::uint16_t cpu_topology::current_numa_node() const noexcept
+{
+	if (m_nodes.size() < 2) {
+		return 0;
+	}
+#if defined(__linux__)
+	const int cpu(sched_getcpu());
+
+	if (!(cpu < 0)) {
+		return numa_node_of((std::uint16_t)cpu);
+	}
+#endif
+	return 0;
+}
+bool cpu_topology::discover_sysfs()
+{
+#if defined(__linux__)
+	const std::string cpuRoot("/sys/devices/system/cpu/");
+	const std::string nodeRoot("/sys/devices/system/node/");
+
+	std::string onlineList;
+	if (!ct_detail::read_line(cpuRoot + "online", onlineList)) {
+		return false;
+	}
+
+	const std::vector<std::uint16_t> online(ct_detail::parse_list(onlineList));
+	if (online.empty()) {
+		return false;
+	}
+
+	for (std::uint16_t index : online) {
+		const std::string topology(cpuRoot + "cpu" + std::to_string(index) + "/topology/");
+
+		logical_core core{};
+		core.index = index;
+
+		if (!ct_detail::read_value(topology + "core_id", core.physicalCore)) {
+			core.physicalCore = index;
+		}
+		if (!ct_detail::read_value(topology + "physical_package_id", core.package)) {
+			core.package = 0;
+		}
+		if (!ct_detail::read_value(cpuRoot + "cpu" + std::to_string(index) + "/cache/index3/id", core.cacheDomain)) {
+			core.cacheDomain = core.package;
+		}
+
+		m_cores.push_back(core);
+	}
+
+	// Nodes without cores attached (memory only) are skipped
+	std::string nodeList;
+	if (ct_detail::read_line(nodeRoot + "online", nodeList)) {
+		for (std::uint16_t node : ct_detail::parse_list(nodeList)) {
+			std::string cpuList;
+			if (!ct_detail::read_line(nodeRoot + "node" + std::to_string(node) + "/cpulist", cpuList)) {
+				continue;
+			}
+
+			const std::vector<std::uint16_t> cpus(ct_detail::parse_list(cpuList));
+
+			bool attached(false);
+			for (logical_core& core : m_cores) {
+				if (std::find(cpus.begin(), cpus.end(), core.index) != cpus.end()) {
+					core.numaNode = (std::uint16_t)m_nodes.size();
+					attached = true;
+				}
+			}
+
+			if (attached) {
+				m_nodes.emplace_back();
+			}
+		}
+	}
+
+	if (m_nodes.empty()) {
+		m_nodes.emplace_back();
+
+		for (logical_core& core : m_cores) {
+			core.numaNode = 0;
+		}
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+void cpu_topology::discover_fallback()
+{
+	const std::uint16_t cores((std::uint16_t)std::max(std::thread::hardware_concurrency(), 1u));
+
+	m_cores.clear();
+	m_nodes.clear();
+
+	for (std::uint16_t i = 0; i < cores; ++i) {
+		m_cores.push_back(logical_core{ i, i, 0, 0, 0 });
+	}
+
+	m_nodes.emplace_back();
+}
+void cpu_topology::build_lookups()
+{
+	std::uint16_t maxIndex(0);
+
+	for (const logical_core& core : m_cores) {
+		m_nodes[core.numaNode].push_back(core.index);
+
+		maxIndex = std::max(maxIndex, core.index);
+	}
+
+	m_coreToNode.resize(std::size_t(maxIndex) + 1, 0);
+
+	for (const logical_core& core : m_cores) {
+		m_coreToNode[core.index] = core.numaNode;
+	}
+
+	// Rank each logical core among its SMT siblings, then order by node, sibling rank and location
+	std::vector<std::pair<std::uint16_t, const logical_core*>> ranked;
+	ranked.reserve(m_cores.size());
+
+	for (const logical_core& core : m_cores) {
+		std::uint16_t rank(0);
+
+		for (const logical_core& other : m_cores) {
+			if (other.index < core.index && other.package == core.package && other.physicalCore == core.physicalCore) {
+				++rank;
+			}
+		}
+
+		ranked.emplace_back(rank, &core);
+	}
+
+	std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+		return std::make_tuple(a.second->numaNode, a.first, a.second->package, a.second->cacheDomain, a.second->index) <
+			std::make_tuple(b.second->numaNode, b.first, b.second->package, b.second->cacheDomain, b.second->index);
+		});
+
+	m_placementOrder.clear();
+	for (const auto& entry : ranked) {
+		m_placementOrder.push_back(entry.second->index);
+	}
+}
+
+const cpu_topology& get_cpu_topology()
+{
+	static const cpu_topology s_topology;
+	return s_topology;
+}
+}
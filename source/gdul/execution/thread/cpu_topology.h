@@ -0,0 +1,119 @@
+// Copyright(c) 2021 Flovin Michaelsen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace gdul {
+
+/// <summary>
+/// Description of a logical core (hardware thread)
+/// </summary>
+struct logical_core
+{
+	// Operating system core index
+	std::uint16_t index;
+	// Physical core id. Logical cores sharing this (and package) are SMT siblings
+	std::uint16_t physicalCore;
+	// Socket
+	std::uint16_t package;
+	// Last level cache domain
+	std::uint16_t cacheDomain;
+	// NUMA node
+	std::uint16_t numaNode;
+};
+
+/// <summary>
+/// Processor topology. On Linux this is read from /sys/devices/system/cpu and /sys/devices/system/node, 
+/// elsewhere it falls back on a single node containing all hardware threads
+/// </summary>
+class cpu_topology
+{
+public:
+	/// <summary>
+	/// Constructor. Performs discovery
+	/// </summary>
+	cpu_topology();
+
+	/// <summary>
+	/// Query for logical cores
+	/// </summary>
+	/// <returns>Number of available logical cores</returns>
+	std::size_t core_count() const noexcept;
+
+	/// <summary>
+	/// Query for NUMA nodes
+	/// </summary>
+	/// <returns>Number of NUMA nodes with cores attached</returns>
+	std::size_t numa_node_count() const noexcept;
+
+	/// <summary>
+	/// Access logical core
+	/// </summary>
+	/// <param name="index">Index in range [0, core_count())</param>
+	/// <returns>Logical core description</returns>
+	const logical_core& core(std::size_t index) const;
+
+	/// <summary>
+	/// Query for cores attached to a NUMA node
+	/// </summary>
+	/// <param name="node">Node in range [0, numa_node_count())</param>
+	/// <returns>Operating system core indices</returns>
+	const std::vector<std::uint16_t>& numa_node_cores(std::size_t node) const;
+
+	/// <summary>
+	/// Ordering of cores suitable for placing one worker per core. Cores are grouped by NUMA node and 
+	/// each physical core is listed once before any of its SMT siblings
+	/// </summary>
+	/// <returns>Operating system core indices</returns>
+	const std::vector<std::uint16_t>& placement_order() const noexcept;
+
+	/// <summary>
+	/// Query for the NUMA node of a core
+	/// </summary>
+	/// <param name="coreIndex">Operating system core index</param>
+	/// <returns>NUMA node</returns>
+	std::uint16_t numa_node_of(std::uint16_t coreIndex) const noexcept;
+
+	/// <summary>
+	/// Query for the NUMA node of the core the calling thread currently runs on
+	/// </summary>
+	/// <returns>NUMA node</returns>
+	std::uint16_t current_numa_node() const noexcept;
+
+private:
+	bool discover_sysfs();
+	void discover_fallback();
+	void build_lookups();
+
+	std::vector<logical_core> m_cores;
+	std::vector<std::vector<std::uint16_t>> m_nodes;
+	std::vector<std::uint16_t> m_placementOrder;
+	std::vector<std::uint16_t> m_coreToNode;
+};
+
+/// <summary>
+/// Lazily discovered topology of this machine
+/// </summary>
+/// <returns>Shared topology instance</returns>
+const cpu_topology& get_cpu_topology();
+}
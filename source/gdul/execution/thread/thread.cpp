@@ -22,10 +22,16 @@
 
 #include <cassert>
 #include <string>
+#include <algorithm>
 
 #if defined(_WIN64) | defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 
 namespace gdul {
@@ -44,24 +50,6 @@ typedef struct tagTHREADNAME_INFO
 #pragma pack(pop)  
 };
 
-void thread::set_name(const std::string& name)
-{
-	assert(valid() && "Cannot set name to invalid thread");
-
-	set_name(name, this->native_handle());
-}
-void thread::set_core_affinity(std::uint8_t core)
-{
-	assert(valid() && "Cannot set affinity to invalid thread");
-
-	set_core_affinity(core, this->native_handle());
-}
-void thread::set_execution_priority(std::int32_t priority)
-{
-	assert(valid() && "Cannot set priority to invalid thread");
-
-	set_execution_priority(priority, this->native_handle());
-}
 void thread::set_name(const std::string& name, std::thread::native_handle_type handle)
 {
 	thread_naming::THREADNAME_INFO info;
@@ -80,15 +68,132 @@ void thread::set_core_affinity(std::uint8_t core, std::thread::native_handle_typ
 {
 	const uint8_t core_(core % std::thread::hardware_concurrency());
 
-	const uint64_t affinityMask(1ULL << core);
+	const uint64_t affinityMask(1ULL << core_);
 	while (!SetThreadAffinityMask(handle, affinityMask));
 }
+void thread::set_core_affinity(const std::vector<std::uint16_t>& cores, std::thread::native_handle_type handle)
+{
+	// Limited to the first processor group
+	uint64_t affinityMask(0);
+	for (std::uint16_t core : cores) {
+		if (core < 64) {
+			affinityMask |= 1ULL << core;
+		}
+	}
+
+	if (affinityMask) {
+		SetThreadAffinityMask(handle, affinityMask);
+	}
+}
 void thread::set_execution_priority(std::int32_t priority, std::thread::native_handle_type handle)
 {
 	SetThreadPriority(handle, priority);
 }
+#elif defined(__linux__)
+void thread::set_name(const std::string& name, std::thread::native_handle_type handle)
+{
+	// Linux thread names are limited to 16 characters, including the terminator
+	const std::string truncated(name.substr(0, 15));
+
+	pthread_setname_np(handle, truncated.c_str());
+}
+void thread::set_core_affinity(std::uint8_t core, std::thread::native_handle_type handle)
+{
+	const uint8_t core_(core % std::thread::hardware_concurrency());
+
+	cpu_set_t affinityMask;
+	CPU_ZERO(&affinityMask);
+	CPU_SET(core_, &affinityMask);
+
+	pthread_setaffinity_np(handle, sizeof(affinityMask), &affinityMask);
+}
+void thread::set_core_affinity(const std::vector<std::uint16_t>& cores, std::thread::native_handle_type handle)
+{
+	cpu_set_t affinityMask;
+	CPU_ZERO(&affinityMask);
+
+	for (std::uint16_t core : cores) {
+		if (core < CPU_SETSIZE) {
+			CPU_SET(core, &affinityMask);
+		}
+	}
+
+	if (CPU_COUNT(&affinityMask)) {
+		pthread_setaffinity_np(handle, sizeof(affinityMask), &affinityMask);
+	}
+}
+void thread::set_execution_priority(std::int32_t priority, [[maybe_unused]] std::thread::native_handle_type handle)
+{
+	assert(pthread_equal(handle, pthread_self()) && "Only the calling thread's kernel id is known from its handle");
+
+	set_execution_priority_by_tid(priority, this_tid());
+}
+void thread::set_execution_priority_by_tid(std::int32_t priority, std::int32_t tid)
+{
+	// Relative levels as with SetThreadPriority, applied as an offset to the process nice value. Real time policies 
+	// are never used. Raising priority above the process' may require CAP_SYS_NICE, and failure is silent, as on Windows
+	constexpr std::int32_t NicePerLevel(5);
+
+	const std::int32_t processNice(getpriority(PRIO_PROCESS, 0));
+	const std::int32_t nice(std::clamp(processNice - priority * NicePerLevel, -20, 19));
+
+	setpriority(PRIO_PROCESS, (id_t)tid, nice);
+}
+std::int32_t thread::this_tid() noexcept
+{
+	return (std::int32_t)syscall(SYS_gettid);
+}
+#else
+void thread::set_name(const std::string&, std::thread::native_handle_type)
+{
+	assert(false && "Not implemented");
+}
+void thread::set_core_affinity(std::uint8_t, std::thread::native_handle_type)
+{
+	assert(false && "Not implemented");
+}
+void thread::set_core_affinity(const std::vector<std::uint16_t>&, std::thread::native_handle_type)
+{
+	assert(false && "Not implemented");
+}
+void thread::set_execution_priority(std::int32_t, std::thread::native_handle_type)
+{
+	assert(false && "Not implemented");
+}
 #endif
+void thread::set_name(const std::string& name)
+{
+	assert(valid() && "Cannot set name to invalid thread");
+
+	set_name(name, this->native_handle());
+}
+void thread::set_core_affinity(std::uint8_t core)
+{
+	assert(valid() && "Cannot set affinity to invalid thread");
+
+	set_core_affinity(core, this->native_handle());
+}
+void thread::set_core_affinity(const std::vector<std::uint16_t>& cores)
+{
+	assert(valid() && "Cannot set affinity to invalid thread");
+
+	set_core_affinity(cores, this->native_handle());
+}
+void thread::set_execution_priority(std::int32_t priority)
+{
+	assert(valid() && "Cannot set priority to invalid thread");
+
+#if defined(__linux__)
+	std::int32_t tid(0);
+	while (!(tid = m_tid->load(std::memory_order_acquire))) {
+		std::this_thread::yield();
+	}
 
+	set_execution_priority_by_tid(priority, tid);
+#else
+	set_execution_priority(priority, this->native_handle());
+#endif
+}
 bool thread::valid() const noexcept
 {
 	return get_id() != std::thread().get_id();
@@ -114,25 +219,44 @@ std::thread::native_handle_type std::this_thread::native_handle()
 {
 	return (std::thread::native_handle_type)GetCurrentThread();
 }
+#elif defined(__linux__)
+void std::this_thread::set_name(const std::string& name)
+{
+	gdul::thread::set_name(name, pthread_self());
+}
+
+void std::this_thread::set_core_affinity(std::uint8_t core)
+{
+	gdul::thread::set_core_affinity(core, pthread_self());
+}
+
+void std::this_thread::set_execution_priority(std::int32_t priority)
+{
+	gdul::thread::set_execution_priority(priority, pthread_self());
+}
+std::thread::native_handle_type std::this_thread::native_handle()
+{
+	return pthread_self();
+}
 #else
 void std::this_thread::set_name(const std::string&)
 {
-	assert(false && "Not implemented")
+	assert(false && "Not implemented");
 }
 
 void std::this_thread::set_core_affinity(std::uint8_t)
 {
-	assert(false && "Not implemented")
+	assert(false && "Not implemented");
 }
 
-void std::this_thread::set_execution_priority(std::uint8_t)
+void std::this_thread::set_execution_priority(std::int32_t)
 {
-	assert(false && "Not implemented")
+	assert(false && "Not implemented");
 }
 std::thread::native_handle_type std::this_thread::native_handle()
 {
-	assert(false && "Not implemented")
-	return nullptr;
+	assert(false && "Not implemented");
+	return std::thread::native_handle_type();
 }
 #endif
 bool std::this_thread::valid() noexcept
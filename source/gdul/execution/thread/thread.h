@@ -22,6 +22,11 @@
 
 #include <thread>
 #include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <type_traits>
 
 namespace std::this_thread {
 void set_name(const std::string& name);
@@ -41,7 +46,10 @@ namespace gdul {
 class thread : public std::thread
 {
 public:
-	using std::thread::thread;
+	thread() noexcept = default;
+
+	template <class Fn, class ...Args, class = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, thread>>>
+	explicit thread(Fn&& fn, Args&&... args);
 
 	/// <summary>
 	/// Set thread name as for debugging
@@ -56,7 +64,14 @@ public:
 	void set_core_affinity(std::uint8_t core);
 
 	/// <summary>
-	/// Set thread execution priority
+	/// Associate thread with a set of cores. The thread may be scheduled on any of them
+	/// </summary>
+	/// <param name="cores">Operating system core indices</param>
+	void set_core_affinity(const std::vector<std::uint16_t>& cores);
+
+	/// <summary>
+	/// Set thread execution priority, relative to normal priority. Values are Windows thread priority levels. 
+	/// On Linux the thread stays on the default time sharing policy, and each level adjusts its nice value by 5
 	/// </summary>
 	/// <param name="priority">Priority value</param>
 	void set_execution_priority(std::int32_t priority);
@@ -76,6 +91,34 @@ private:
 
 	static void set_name(const std::string& name, std::thread::native_handle_type handle);
 	static void set_core_affinity(std::uint8_t core, std::thread::native_handle_type handle);
+	static void set_core_affinity(const std::vector<std::uint16_t>& cores, std::thread::native_handle_type handle);
 	static void set_execution_priority(std::int32_t priority, std::thread::native_handle_type handle);
+
+#if defined(__linux__)
+	// Nice values are set per kernel thread id, which pthread handles do not expose
+	static void set_execution_priority_by_tid(std::int32_t priority, std::int32_t tid);
+	static std::int32_t this_tid() noexcept;
+
+	// Published by the thread as it starts
+	std::shared_ptr<std::atomic<std::int32_t>> m_tid;
+#endif
 };
+
+template<class Fn, class ...Args, class>
+inline thread::thread(Fn&& fn, Args&& ...args)
+#if defined(__linux__)
+	: std::thread()
+	, m_tid(std::make_shared<std::atomic<std::int32_t>>(0))
+{
+	static_cast<std::thread&>(*this) = std::thread([tid = m_tid](auto&& fn_, auto&&... args_) {
+		tid->store(this_tid(), std::memory_order_release);
+
+		std::invoke(std::forward<decltype(fn_)>(fn_), std::forward<decltype(args_)>(args_)...);
+		}, std::forward<Fn>(fn), std::forward<Args>(args)...);
+}
+#else
+	: std::thread(std::forward<Fn>(fn), std::forward<Args>(args)...)
+{
+}
+#endif
 }
\ No newline at end of file
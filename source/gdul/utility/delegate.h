@@ -401,6 +401,13 @@ public:
 	}
 };
 
+template <class T>
+struct is_delegate : std::false_type {};
+template <class Signature>
+struct is_delegate<delegate<Signature>> : std::true_type {};
+template <class T>
+constexpr bool is_delegate_v = is_delegate<T>::value;
+
 template <class Callable, class ...BoundArgs>
 delegate<typename del_detail::evaluate_partial_signature<Callable, BoundArgs...>::signature> make_delegate(Callable&& callable, BoundArgs&& ... boundArgs)
 {